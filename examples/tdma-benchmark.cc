@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Scalability benchmark of the TDMA module. Every combination of the node
+ * counts, slots per node, densities and packet rates given is simulated in
+ * turn, without the internet stack: each node broadcasts fixed size packets
+ * straight to its TdmaNetDevice and the frames received are counted at the
+ * devices. One CSV line is printed per run:
+ *
+ *   nodes,slots,density,rate,simTime,wallMs,events,eventsPerSec,peakRssKb,
+ *   txPackets,rxPackets,throughputBps
+ *
+ * density is the mean number of nodes within MaxRange of a node, rate the
+ * packets sent per second by each node, txPackets the frames put on the
+ * channel and throughputBps the bits received per second over all nodes.
+ * simTime is the simulated time of the run, stretched to minFrames TDMA
+ * frames when these are longer than --simTime, so that every node gets
+ * its slots. peakRssKb is the peak resident set size of the
+ * process so far; run one point per process for exact per-run figures.
+ *
+ * ./waf --run "tdma-benchmark --nodes=10,100,1000,10000,50000 --density=10,50"
+ */
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/simple-wireless-tdma-module.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TdmaBenchmark");
+
+static std::vector<double>
+ParseList (std::string list)
+{
+  std::vector<double> values;
+  std::istringstream is (list);
+  std::string value;
+  while (std::getline (is, value, ','))
+    {
+      values.push_back (std::atof (value.c_str ()));
+    }
+  NS_ABORT_MSG_IF (values.empty (), "Empty list " << list);
+  return values;
+}
+
+class TdmaBenchmark
+{
+public:
+  TdmaBenchmark ();
+  void Run (uint32_t nNodes, uint32_t slotsPerNode, double density, double rate, std::ostream &os);
+
+  double m_simTime;
+  uint32_t m_minFrames;
+  double m_range;
+  uint32_t m_packetSize;
+  uint32_t m_slotTime;
+  uint32_t m_guardTime;
+  bool m_slotScheduler;
+
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  void Send (Ptr<NetDevice> device, Time interval);
+  void MacTx (Ptr<const Packet> packet);
+
+  uint64_t m_txPackets;
+  uint64_t m_rxPackets;
+  uint64_t m_rxBytes;
+};
+
+TdmaBenchmark::TdmaBenchmark ()
+  : m_simTime (10.0),
+    m_minFrames (3),
+    m_range (250.0),
+    m_packetSize (1000),
+    m_slotTime (1100),
+    m_guardTime (100),
+    m_slotScheduler (false),
+    m_txPackets (0),
+    m_rxPackets (0),
+    m_rxBytes (0)
+{
+}
+
+bool
+TdmaBenchmark::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxPackets++;
+  m_rxBytes += packet->GetSize ();
+  return true;
+}
+
+void
+TdmaBenchmark::Send (Ptr<NetDevice> device, Time interval)
+{
+  device->Send (Create<Packet> (m_packetSize), device->GetBroadcast (), 0x0800);
+  Simulator::Schedule (interval, &TdmaBenchmark::Send, this, device, interval);
+}
+
+void
+TdmaBenchmark::MacTx (Ptr<const Packet> packet)
+{
+  m_txPackets++;
+}
+
+void
+TdmaBenchmark::Run (uint32_t nNodes, uint32_t slotsPerNode, double density, double rate, std::ostream &os)
+{
+  m_txPackets = 0;
+  m_rxPackets = 0;
+  m_rxBytes = 0;
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  // square holding nNodes with density nodes per MaxRange disc on average
+  double side = std::sqrt (nNodes * M_PI * m_range * m_range / density);
+  std::ostringstream bound;
+  bound << "ns3::UniformRandomVariable[Min=0.0|Max=" << side << "]";
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue (bound.str ()),
+                                 "Y", StringValue (bound.str ()));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Config::SetDefault ("ns3::SimpleWirelessChannel::MaxRange", DoubleValue (m_range));
+  TdmaHelper tdma = TdmaHelper (nNodes, nNodes * slotsPerNode);
+  TdmaControllerHelper controller;
+  controller.Set ("SlotTime", TimeValue (MicroSeconds (m_slotTime)));
+  controller.Set ("GuardTime", TimeValue (MicroSeconds (m_guardTime)));
+  controller.Set ("InterFrameTime", TimeValue (MicroSeconds (0)));
+  tdma.SetTdmaControllerHelper (controller);
+  if (m_slotScheduler)
+    {
+      tdma.EnableSlotScheduler ();
+    }
+  NetDeviceContainer devices = tdma.Install (nodes);
+
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  Time interval = Seconds (1.0 / rate);
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      (*i)->SetReceiveCallback (MakeCallback (&TdmaBenchmark::Receive, this));
+      DynamicCast<TdmaNetDevice> (*i)->GetMac ()->TraceConnectWithoutContext ("MacTx", MakeCallback (&TdmaBenchmark::MacTx, this));
+      Simulator::Schedule (Seconds (start->GetValue (0, interval.GetSeconds ())),
+                           &TdmaBenchmark::Send, this, *i, interval);
+    }
+
+  // each node sends its slots in one grant followed by a guard time
+  double frameTime = nNodes * (slotsPerNode * m_slotTime + m_guardTime) * 1e-6;
+  double simTime = std::max (m_simTime, m_minFrames * frameTime);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  int64_t wallMs = clock.End ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  os << nNodes << ',' << nNodes * slotsPerNode << ',' << density << ',' << rate << ','
+     << simTime << ',' << wallMs << ',' << events << ','
+     << (wallMs > 0 ? events * 1000.0 / wallMs : 0) << ',' << usage.ru_maxrss << ','
+     << m_txPackets << ',' << m_rxPackets << ',' << m_rxBytes * 8 / simTime << std::endl;
+}
+
+int main (int argc, char **argv)
+{
+  TdmaBenchmark benchmark;
+  std::string nodes = "10,100,1000,10000,50000";
+  std::string slots = "1";
+  std::string density = "10";
+  std::string rate = "1";
+  std::string CSVfileName = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Node counts [Default:10,100,1000,10000,50000]", nodes);
+  cmd.AddValue ("slots", "Slots per node in a frame [Default:1]", slots);
+  cmd.AddValue ("density", "Mean number of nodes within range of a node [Default:10]", density);
+  cmd.AddValue ("rate", "Packets sent per second by each node [Default:1]", rate);
+  cmd.AddValue ("simTime", "Simulated time of each run in seconds [Default:10]", benchmark.m_simTime);
+  cmd.AddValue ("minFrames", "Least number of TDMA frames simulated per run [Default:3]", benchmark.m_minFrames);
+  cmd.AddValue ("range", "MaxRange of the channel in meters [Default:250]", benchmark.m_range);
+  cmd.AddValue ("packetSize", "Packet size in bytes [Default:1000]", benchmark.m_packetSize);
+  cmd.AddValue ("slotTime", "Slot transmission Time [Default(us):1100]", benchmark.m_slotTime);
+  cmd.AddValue ("guardTime", "Duration to wait between slots [Default(us):100]", benchmark.m_guardTime);
+  cmd.AddValue ("slotScheduler", "Schedule events with a TdmaSlotScheduler [Default:0]", benchmark.m_slotScheduler);
+  cmd.AddValue ("CSVfileName", "CSV file to write, standard output if empty", CSVfileName);
+  cmd.Parse (argc, argv);
+
+  std::ofstream file;
+  if (!CSVfileName.empty ())
+    {
+      file.open (CSVfileName.c_str ());
+    }
+  std::ostream &os = CSVfileName.empty () ? std::cout : file;
+  os << "nodes,slots,density,rate,simTime,wallMs,events,eventsPerSec,peakRssKb,"
+     << "txPackets,rxPackets,throughputBps" << std::endl;
+
+  std::vector<double> nodeList = ParseList (nodes);
+  std::vector<double> slotList = ParseList (slots);
+  std::vector<double> densityList = ParseList (density);
+  std::vector<double> rateList = ParseList (rate);
+  for (uint32_t n = 0; n < nodeList.size (); n++)
+    {
+      for (uint32_t s = 0; s < slotList.size (); s++)
+        {
+          for (uint32_t d = 0; d < densityList.size (); d++)
+            {
+              for (uint32_t r = 0; r < rateList.size (); r++)
+                {
+                  benchmark.Run (nodeList[n], slotList[s], densityList[d], rateList[r], os);
+                }
+            }
+        }
+    }
+  return 0;
+}
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Dense broadcast scenario run over the cores of a machine with MPI. The
+ * nodes are placed at random in a square and partitioned into vertical
+ * strips, one per rank, so that most neighbours share a rank and most
+ * frames are received where they are sent. Every node broadcasts fixed
+ * size packets straight to its TdmaNetDevice, and each rank prints, once
+ * done, a CSV line counting the frames sent and received by its nodes:
+ *
+ *   rank,ranks,nodes,localNodes,wallMs,events,txPackets,rxPackets,remoteFrames
+ *
+ * remoteFrames is the number of frames received from other ranks.
+ *
+ * mpirun -np 32 ./build/src/simple-wireless-tdma/examples/ns3.24.1-tdma-distributed-debug --nodes=10000
+ */
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/simple-wireless-tdma-module.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TdmaDistributed");
+
+class TdmaDistributed
+{
+public:
+  TdmaDistributed ();
+  void Run (void);
+
+  uint32_t m_nodes;
+  double m_density;
+  double m_rate;
+  double m_simTime;
+  double m_range;
+  uint32_t m_packetSize;
+  uint32_t m_slotTime;
+  uint32_t m_guardTime;
+
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  void Send (Ptr<NetDevice> device, Time interval);
+
+  uint32_t m_rank;
+  std::map<Address, uint32_t> m_ranks; //!< rank of every device, by address
+  uint64_t m_txPackets;
+  uint64_t m_rxPackets;
+  uint64_t m_remoteFrames;
+};
+
+TdmaDistributed::TdmaDistributed ()
+  : m_nodes (1000),
+    m_density (50),
+    m_rate (1),
+    m_simTime (10.0),
+    m_range (250.0),
+    m_packetSize (1000),
+    m_slotTime (1100),
+    m_guardTime (100),
+    m_rank (0),
+    m_txPackets (0),
+    m_rxPackets (0),
+    m_remoteFrames (0)
+{
+}
+
+bool
+TdmaDistributed::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxPackets++;
+  if (m_ranks[from] != m_rank)
+    {
+      m_remoteFrames++;
+    }
+  return true;
+}
+
+void
+TdmaDistributed::Send (Ptr<NetDevice> device, Time interval)
+{
+  device->Send (Create<Packet> (m_packetSize), device->GetBroadcast (), 0x0800);
+  m_txPackets++;
+  Simulator::Schedule (interval, &TdmaDistributed::Send, this, device, interval);
+}
+
+void
+TdmaDistributed::Run (void)
+{
+  m_rank = MpiInterface::GetSystemId ();
+  uint32_t ranks = MpiInterface::GetSize ();
+
+  // square holding m_nodes with m_density nodes per MaxRange disc on
+  // average; every rank draws the same positions
+  double side = std::sqrt (m_nodes * M_PI * m_range * m_range / m_density);
+  Ptr<UniformRandomVariable> position = CreateObject<UniformRandomVariable> ();
+  position->SetAttribute ("Max", DoubleValue (side));
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  NodeContainer nodes;
+  uint32_t localNodes = 0;
+  for (uint32_t i = 0; i < m_nodes; i++)
+    {
+      double x = position->GetValue ();
+      double y = position->GetValue ();
+      positions->Add (Vector (x, y, 0));
+      uint32_t rank = std::min (ranks - 1, uint32_t (x / side * ranks));
+      nodes.Add (CreateObject<Node> (rank));
+      localNodes += (rank == m_rank);
+    }
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Config::SetDefault ("ns3::SimpleWirelessChannel::MaxRange", DoubleValue (m_range));
+  TdmaHelper tdma = TdmaHelper (m_nodes, m_nodes);
+  TdmaControllerHelper controller;
+  controller.Set ("SlotTime", TimeValue (MicroSeconds (m_slotTime)));
+  controller.Set ("GuardTime", TimeValue (MicroSeconds (m_guardTime)));
+  controller.Set ("InterFrameTime", TimeValue (MicroSeconds (0)));
+  tdma.SetTdmaControllerHelper (controller);
+  tdma.EnableDistributed ();
+  NetDeviceContainer devices = tdma.Install (nodes);
+  tdma.InstallLookaheadLinks (nodes);
+
+  // traffic only starts at the nodes of this rank
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  Time interval = Seconds (1.0 / m_rate);
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      uint32_t rank = (*i)->GetNode ()->GetSystemId ();
+      m_ranks[(*i)->GetAddress ()] = rank;
+      // drawn for every node, so start times do not depend on the ranks
+      Time delay = Seconds (start->GetValue (0, interval.GetSeconds ()));
+      if (rank != m_rank)
+        {
+          continue;
+        }
+      (*i)->SetReceiveCallback (MakeCallback (&TdmaDistributed::Receive, this));
+      Simulator::ScheduleWithContext ((*i)->GetNode ()->GetId (), delay,
+                                      &TdmaDistributed::Send, this, *i, interval);
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (m_simTime));
+  Simulator::Run ();
+  int64_t wallMs = clock.End ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::cout << m_rank << ',' << ranks << ',' << m_nodes << ',' << localNodes << ','
+            << wallMs << ',' << events << ',' << m_txPackets << ',' << m_rxPackets << ','
+            << m_remoteFrames << std::endl;
+}
+
+int main (int argc, char **argv)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+  MpiInterface::Enable (&argc, &argv);
+
+  TdmaDistributed scenario;
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes [Default:1000]", scenario.m_nodes);
+  cmd.AddValue ("density", "Mean number of nodes within range of a node [Default:50]", scenario.m_density);
+  cmd.AddValue ("rate", "Packets sent per second by each node [Default:1]", scenario.m_rate);
+  cmd.AddValue ("simTime", "Simulated time in seconds [Default:10]", scenario.m_simTime);
+  cmd.AddValue ("range", "MaxRange of the channel in meters [Default:250]", scenario.m_range);
+  cmd.AddValue ("packetSize", "Packet size in bytes [Default:1000]", scenario.m_packetSize);
+  cmd.AddValue ("slotTime", "Slot transmission Time [Default(us):1100]", scenario.m_slotTime);
+  cmd.AddValue ("guardTime", "Duration to wait between slots [Default(us):100]", scenario.m_guardTime);
+  cmd.Parse (argc, argv);
+
+  if (MpiInterface::GetSystemId () == 0)
+    {
+      std::cout << "rank,ranks,nodes,localNodes,wallMs,events,txPackets,rxPackets,remoteFrames" << std::endl;
+    }
+  scenario.Run ();
+  MpiInterface::Disable ();
+  return 0;
+}
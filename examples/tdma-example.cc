@@ -65,7 +65,8 @@ public:
                 uint32_t nSlots,
                 uint32_t slotTime,
                 uint32_t guardTime,
-                uint32_t interFrameGap);
+                uint32_t interFrameGap,
+                bool staticRouting);
 
 private:
   uint32_t m_nWifis;
@@ -84,6 +85,7 @@ private:
   uint32_t m_slotTime;
   uint32_t m_guardTime;
   uint32_t m_interFrameGap;
+  bool m_staticRouting;
 
   std::map<double, double> m_transmitRangeMap;
 
@@ -127,6 +129,7 @@ int main (int argc, char **argv)
   uint32_t slotTime = 1000 * 8 / 8000 * 1000000; // us
   uint32_t interFrameGap = 0;
   uint32_t guardTime = 0;
+  bool staticRouting = false;
 
   CommandLine cmd;
   cmd.AddValue ("nWifis", "Number of wifi nodes[Default:30]", nWifis);
@@ -145,7 +148,10 @@ int main (int argc, char **argv)
   cmd.AddValue ("slotTime", "Slot transmission Time [Default(us):1000]", slotTime);
   cmd.AddValue ("guardTime", "Duration to wait between slots [Default(us):0]", guardTime);
   cmd.AddValue ("interFrameGap", "Duration between frames [Default(us):0]", interFrameGap);
+  cmd.AddValue ("staticRouting", "Install shortest path static routes instead of DSDV, "
+                "so dataStart can be 0 (TDMA only) [Default:false(0)]", staticRouting);
   cmd.Parse (argc, argv);
+  NS_ABORT_MSG_IF (staticRouting && usingWifi, "staticRouting requires the TDMA devices");
 
   std::ofstream out (CSVfileName.c_str ());
   out << "SimulationSecond," <<
@@ -164,7 +170,8 @@ int main (int argc, char **argv)
 
   test = TdmaExample ();
   test.CaseRun (nWifis, nSinks, totalTime, rate, phyMode, nodeSpeed, periodicUpdateInterval,
-                settlingTime, dataStart,CSVfileName,usingWifi,txpDistance, nSlots, slotTime, guardTime, interFrameGap);
+                settlingTime, dataStart,CSVfileName,usingWifi,txpDistance, nSlots, slotTime, guardTime, interFrameGap,
+                staticRouting);
 
   return 0;
 }
@@ -185,7 +192,8 @@ TdmaExample::TdmaExample ()
 	  m_slots(30),
 	  m_slotTime (1000),
     m_guardTime (0),
-	  m_interFrameGap (0)
+	  m_interFrameGap (0),
+    m_staticRouting (false)
 
 {
   NS_LOG_FUNCTION (this);
@@ -235,7 +243,7 @@ void
 TdmaExample::CaseRun (uint32_t nWifis, uint32_t nSinks, double totalTime, std::string rate,
                       std::string phyMode, uint32_t nodeSpeed, uint32_t periodicUpdateInterval, uint32_t settlingTime,
                       double dataStart, std::string CSVfileName, bool usingWifi, double txpDistance, uint32_t nSlots,
-                      uint32_t slotTime, uint32_t guardTime, uint32_t interFrameGap)
+                      uint32_t slotTime, uint32_t guardTime, uint32_t interFrameGap, bool staticRouting)
 {
   m_nWifis = nWifis;
   m_nSinks = nSinks;
@@ -251,6 +259,7 @@ TdmaExample::CaseRun (uint32_t nWifis, uint32_t nSinks, double totalTime, std::s
   m_slotTime = slotTime;
   m_guardTime = guardTime;
   m_interFrameGap = interFrameGap;
+  m_staticRouting = staticRouting;
 
   std::stringstream ss;
   ss << m_nWifis;
@@ -401,6 +410,17 @@ TdmaExample::CreateDevices (std::string tr_name, bool usingWifi, double txpDista
 void
 TdmaExample::InstallInternetStack ()
 {
+  if (m_staticRouting)
+    {
+      InternetStackHelper stack;
+      stack.Install (nodes);
+      Ipv4AddressHelper address;
+      address.SetBase ("10.1.1.0", "255.255.255.0");
+      interfaces = address.Assign (devices);
+      TdmaStaticRoutingHelper routing;
+      routing.PopulateRoutingTables (devices);
+      return;
+    }
   DsdvHelper dsdv;
   dsdv.Set ("PeriodicUpdateInterval", TimeValue (Seconds (m_periodicUpdateInterval)));
   dsdv.Set ("SettlingTime", TimeValue (Seconds (m_settlingTime)));
@@ -0,0 +1,272 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Microbenchmarks of the hot paths of the TDMA module, without the
+ * internet stack or applications. Each prints one CSV line per parameter
+ * value with the cost of one operation in nanoseconds:
+ *
+ *   benchmark,param,ops,wallMs,nsPerOp
+ *
+ * queue-enqueue-dequeue  one Enqueue and one Dequeue of TdmaMacQueue with
+ *                        param packets queued
+ * queue-expiry           dropping one expired packet of a queue of param
+ *                        packets
+ * channel-fanout         one broadcast frame sent through
+ *                        SimpleWirelessChannel and received by param
+ *                        devices in range
+ * controller-slot        one slot scheduled by TdmaController with param
+ *                        slots per frame
+ *
+ * ./waf --run "tdma-microbenchmark --depths=1,100,1000 --neighbours=1,10,100"
+ */
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/simple-wireless-tdma-module.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <time.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TdmaMicrobenchmark");
+
+static uint64_t g_count = 0;
+
+static std::vector<uint32_t>
+ParseList (std::string list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream is (list);
+  std::string value;
+  while (std::getline (is, value, ','))
+    {
+      values.push_back (std::atoi (value.c_str ()));
+    }
+  NS_ABORT_MSG_IF (values.empty (), "Empty list " << list);
+  return values;
+}
+
+static void
+Report (std::string name, uint32_t param, uint64_t ops, double wallMs)
+{
+  std::cout << name << ',' << param << ',' << ops << ',' << wallMs << ','
+            << (ops > 0 ? wallMs * 1e6 / ops : 0) << std::endl;
+}
+
+// nanosecond clock, for operations too short for SystemWallClockMs
+static uint64_t
+NowNs (void)
+{
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void
+CountPacket (Ptr<const Packet> packet)
+{
+  g_count++;
+}
+
+static bool
+CountReceive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  g_count++;
+  return true;
+}
+
+static void
+CountSlot (uint32_t slot, uint16_t channelNumber, Ptr<TdmaMac> owner, Time duration)
+{
+  g_count++;
+}
+
+static void
+QueueEnqueueDequeue (uint32_t depth, uint64_t ops)
+{
+  Ptr<TdmaMacQueue> queue = CreateObject<TdmaMacQueue> ();
+  queue->SetMaxSize (depth + 1);
+  queue->SetTdmaMacTxDropCallback (MakeCallback (&CountPacket));
+  Ptr<const Packet> packet = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  for (uint32_t i = 0; i < depth; i++)
+    {
+      queue->Enqueue (packet, hdr);
+    }
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint64_t i = 0; i < ops; i++)
+    {
+      queue->Enqueue (packet, hdr);
+      queue->Dequeue (&hdr);
+    }
+  Report ("queue-enqueue-dequeue", depth, ops, clock.End ());
+}
+
+static void
+QueueExpiry (uint32_t depth, uint64_t ops)
+{
+  Ptr<TdmaMacQueue> queue = CreateObject<TdmaMacQueue> ();
+  queue->SetMaxSize (depth);
+  queue->SetTdmaMacTxDropCallback (MakeCallback (&CountPacket));
+  Ptr<const Packet> packet = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  g_count = 0;
+  uint64_t wallNs = 0;
+  while (g_count < ops)
+    {
+      queue->SetMaxDelay (Seconds (10));
+      for (uint32_t i = 0; i < depth; i++)
+        {
+          queue->Enqueue (packet, hdr);
+        }
+      // every packet is expired once MaxDelay is zero
+      queue->SetMaxDelay (Seconds (0));
+      uint64_t start = NowNs ();
+      queue->IsEmpty ();
+      wallNs += NowNs () - start;
+    }
+  Report ("queue-expiry", depth, g_count, wallNs / 1e6);
+}
+
+static void
+SendBroadcast (Ptr<TdmaMacLow> low, Time txTime, uint64_t left)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+  hdr.SetAddr2 (low->GetAddress ());
+  hdr.SetAddr3 (low->GetAddress ());
+  Ptr<Packet> packet = Create<Packet> (1000);
+  LlcSnapHeader llc;
+  llc.SetType (0x0800);
+  packet->AddHeader (llc);
+  low->StartTransmission (packet, &hdr, txTime);
+  if (left > 1)
+    {
+      Simulator::Schedule (txTime, &SendBroadcast, low, txTime, left - 1);
+    }
+}
+
+static void
+ChannelFanout (uint32_t neighbours, uint64_t ops)
+{
+  NodeContainer nodes;
+  nodes.Create (neighbours + 1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  // a single grant for the whole run, so the controller stays out of the way
+  TdmaHelper tdma = TdmaHelper (nodes.GetN (), nodes.GetN ());
+  TdmaControllerHelper controller;
+  controller.Set ("SlotTime", TimeValue (Seconds (1000)));
+  tdma.SetTdmaControllerHelper (controller);
+  NetDeviceContainer devices = tdma.Install (nodes);
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      (*i)->SetReceiveCallback (MakeCallback (&CountReceive));
+    }
+  Ptr<TdmaNetDevice> device = DynamicCast<TdmaNetDevice> (devices.Get (0));
+  Ptr<TdmaMacLow> low = DynamicCast<TdmaCentralMac> (device->GetMac ())->GetTdmaMacLow ();
+  Time txTime = MicroSeconds (100);
+  Simulator::Schedule (MicroSeconds (1), &SendBroadcast, low, txTime, ops);
+
+  g_count = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (MicroSeconds (1 + 100 * (ops + 1)));
+  Simulator::Run ();
+  int64_t wallMs = clock.End ();
+  Simulator::Destroy ();
+  NS_ASSERT_MSG (g_count == ops * neighbours, "received " << g_count << " frames of " << ops * neighbours);
+  Report ("channel-fanout", neighbours, ops, wallMs);
+}
+
+static void
+ControllerSlot (uint32_t slots, uint64_t ops)
+{
+  NodeContainer nodes;
+  nodes.Create (slots);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  TdmaHelper tdma = TdmaHelper (slots, slots);
+  TdmaControllerHelper controller;
+  controller.Set ("SlotTime", TimeValue (MicroSeconds (1000)));
+  controller.Set ("GuardTime", TimeValue (MicroSeconds (0)));
+  tdma.SetTdmaControllerHelper (controller);
+  tdma.Install (nodes);
+  tdma.GetTdmaController ()->TraceConnectWithoutContext ("SlotStart", MakeCallback (&CountSlot));
+
+  g_count = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (MicroSeconds (1000 * ops));
+  Simulator::Run ();
+  int64_t wallMs = clock.End ();
+  Simulator::Destroy ();
+  Report ("controller-slot", slots, g_count, wallMs);
+}
+
+int main (int argc, char **argv)
+{
+  std::string depths = "1,10,100,400";
+  std::string neighbours = "1,10,100,1000";
+  std::string slots = "10,100,1000";
+  uint64_t ops = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("depths", "Queue depths [Default:1,10,100,400]", depths);
+  cmd.AddValue ("neighbours", "Devices in range of the sender [Default:1,10,100,1000]", neighbours);
+  cmd.AddValue ("slots", "Slots per frame [Default:10,100,1000]", slots);
+  cmd.AddValue ("ops", "Operations per measure [Default:1000000]", ops);
+  cmd.Parse (argc, argv);
+
+  std::cout << "benchmark,param,ops,wallMs,nsPerOp" << std::endl;
+  std::vector<uint32_t> depthList = ParseList (depths);
+  for (uint32_t i = 0; i < depthList.size (); i++)
+    {
+      QueueEnqueueDequeue (depthList[i], ops);
+    }
+  for (uint32_t i = 0; i < depthList.size (); i++)
+    {
+      QueueExpiry (depthList[i], ops);
+    }
+  std::vector<uint32_t> neighbourList = ParseList (neighbours);
+  for (uint32_t i = 0; i < neighbourList.size (); i++)
+    {
+      // keep the frames received per measure bounded
+      ChannelFanout (neighbourList[i], std::max<uint64_t> (ops / neighbourList[i] / 10, 1));
+    }
+  std::vector<uint32_t> slotList = ParseList (slots);
+  for (uint32_t i = 0; i < slotList.size (); i++)
+    {
+      ControllerSlot (slotList[i], ops / 10);
+    }
+  return 0;
+}
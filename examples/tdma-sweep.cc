@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Runs a simulation program over a parameter grid and several
+ * replications, in parallel worker processes, and merges the CSV files of
+ * the runs into one.
+ *
+ * Every point of the grid is run once per run number, each replication
+ * being a separate process started with its own --RngRun and with the
+ * working directory <prefix>-<index>, so that the traces of concurrent
+ * runs do not overwrite each other. Up to jobs processes run at a time.
+ * Each run writes its results to the CSV file given by --<csvArg>=run.csv;
+ * the merged file has the run number and the grid parameters prepended to
+ * every line.
+ *
+ * ./waf --run "tdma-sweep --program=/path/to/tdma-example
+ *     --grid=nWifis=10,20;txpDistance=200,400 --runs=10
+ *     --inputs=/path/to/tdmaSlots.txt --output=sweep.csv"
+ */
+#include "ns3/core-module.h"
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TdmaSweep");
+
+struct Job
+{
+  uint32_t index;
+  uint32_t run;
+  std::vector<std::string> values;
+  std::string directory;
+};
+
+static std::vector<std::string>
+Split (std::string list, char separator)
+{
+  std::vector<std::string> items;
+  std::istringstream is (list);
+  std::string item;
+  while (std::getline (is, item, separator))
+    {
+      if (!item.empty ())
+        {
+          items.push_back (item);
+        }
+    }
+  return items;
+}
+
+static std::string
+GetBaseName (std::string path)
+{
+  std::string::size_type slash = path.rfind ('/');
+  return slash == std::string::npos ? path : path.substr (slash + 1);
+}
+
+static pid_t
+Launch (const Job &job, std::string program, const std::vector<std::string> &names,
+        const std::vector<std::string> &inputs, std::string csvArg)
+{
+  NS_ABORT_MSG_IF (mkdir (job.directory.c_str (), 0755) != 0 && errno != EEXIST,
+                   "Couldn't create " << job.directory);
+  std::vector<std::string> args;
+  args.push_back (program);
+  std::ostringstream run;
+  run << "--RngRun=" << job.run;
+  args.push_back (run.str ());
+  args.push_back ("--" + csvArg + "=run.csv");
+  for (uint32_t i = 0; i < names.size (); i++)
+    {
+      args.push_back ("--" + names[i] + "=" + job.values[i]);
+    }
+
+  pid_t pid = fork ();
+  NS_ABORT_MSG_IF (pid < 0, "Couldn't fork: " << std::strerror (errno));
+  if (pid > 0)
+    {
+      return pid;
+    }
+  // child: run the program in its own directory, with the input files it reads
+  if (chdir (job.directory.c_str ()) != 0)
+    {
+      _exit (127);
+    }
+  for (uint32_t i = 0; i < inputs.size (); i++)
+    {
+      std::string link = GetBaseName (inputs[i]);
+      unlink (link.c_str ());
+      if (symlink (inputs[i].c_str (), link.c_str ()) != 0)
+        {
+          _exit (127);
+        }
+    }
+  if (!freopen ("run.log", "w", stdout) || !freopen ("run.log", "a", stderr))
+    {
+      _exit (127);
+    }
+  std::vector<char *> argv;
+  for (uint32_t i = 0; i < args.size (); i++)
+    {
+      argv.push_back (const_cast<char *> (args[i].c_str ()));
+    }
+  argv.push_back (0);
+  execv (program.c_str (), &argv[0]);
+  _exit (127);
+}
+
+int main (int argc, char **argv)
+{
+  std::string program = "";
+  std::string grid = "";
+  uint32_t runs = 1;
+  uint32_t firstRun = 1;
+  uint32_t jobs = sysconf (_SC_NPROCESSORS_ONLN);
+  std::string inputs = "";
+  std::string csvArg = "CSVfileName";
+  std::string prefix = "sweep";
+  std::string output = "sweep.csv";
+
+  CommandLine cmd;
+  cmd.AddValue ("program", "Absolute path of the program to run", program);
+  cmd.AddValue ("grid", "Parameter grid, as name=value,value;name=value,...", grid);
+  cmd.AddValue ("runs", "Replications of every point of the grid [Default:1]", runs);
+  cmd.AddValue ("firstRun", "RngRun of the first replication [Default:1]", firstRun);
+  cmd.AddValue ("jobs", "Processes run at a time [Default:number of cores]", jobs);
+  cmd.AddValue ("inputs", "Absolute paths of files the program reads from its working directory, comma separated", inputs);
+  cmd.AddValue ("csvArg", "Argument of the program naming its CSV output [Default:CSVfileName]", csvArg);
+  cmd.AddValue ("prefix", "Prefix of the working directories of the runs [Default:sweep]", prefix);
+  cmd.AddValue ("output", "Merged CSV file [Default:sweep.csv]", output);
+  cmd.Parse (argc, argv);
+  NS_ABORT_MSG_IF (program.empty () || program[0] != '/', "--program must be an absolute path");
+  NS_ABORT_MSG_IF (jobs == 0, "--jobs must be at least 1");
+
+  // grid points, the first parameter varying slowest
+  std::vector<std::string> names;
+  std::vector<std::vector<std::string> > points (1);
+  std::vector<std::string> parameters = Split (grid, ';');
+  for (uint32_t i = 0; i < parameters.size (); i++)
+    {
+      std::string::size_type equal = parameters[i].find ('=');
+      NS_ABORT_MSG_IF (equal == std::string::npos, "Expected name=values in " << parameters[i]);
+      names.push_back (parameters[i].substr (0, equal));
+      std::vector<std::string> values = Split (parameters[i].substr (equal + 1), ',');
+      NS_ABORT_MSG_IF (values.empty (), "No value for " << names.back ());
+      std::vector<std::vector<std::string> > expanded;
+      for (uint32_t p = 0; p < points.size (); p++)
+        {
+          for (uint32_t v = 0; v < values.size (); v++)
+            {
+              expanded.push_back (points[p]);
+              expanded.back ().push_back (values[v]);
+            }
+        }
+      points.swap (expanded);
+    }
+
+  std::vector<Job> jobList;
+  for (uint32_t p = 0; p < points.size (); p++)
+    {
+      for (uint32_t r = 0; r < runs; r++)
+        {
+          Job job;
+          job.index = jobList.size ();
+          job.run = firstRun + r;
+          job.values = points[p];
+          std::ostringstream directory;
+          directory << prefix << "-" << job.index;
+          job.directory = directory.str ();
+          jobList.push_back (job);
+        }
+    }
+
+  std::vector<std::string> inputList = Split (inputs, ',');
+  std::map<pid_t, uint32_t> running;
+  std::vector<bool> succeeded (jobList.size (), false);
+  uint32_t next = 0;
+  while (next < jobList.size () || !running.empty ())
+    {
+      if (next < jobList.size () && running.size () < jobs)
+        {
+          running[Launch (jobList[next], program, names, inputList, csvArg)] = next;
+          next++;
+          continue;
+        }
+      int status;
+      pid_t pid = waitpid (-1, &status, 0);
+      if (pid < 0)
+        {
+          NS_ABORT_MSG_IF (errno != EINTR, "waitpid failed: " << std::strerror (errno));
+          continue;
+        }
+      std::map<pid_t, uint32_t>::iterator it = running.find (pid);
+      if (it == running.end ())
+        {
+          continue;
+        }
+      const Job &job = jobList[it->second];
+      succeeded[job.index] = WIFEXITED (status) && WEXITSTATUS (status) == 0;
+      std::cerr << job.directory << " run " << job.run
+                << (succeeded[job.index] ? " done" : " failed, see run.log") << std::endl;
+      running.erase (it);
+    }
+
+  // merge the CSV files, keeping the header of the first one
+  std::ofstream out (output.c_str ());
+  NS_ABORT_MSG_UNLESS (out.is_open (), "Couldn't open " << output);
+  bool header = false;
+  uint32_t failed = 0;
+  for (uint32_t j = 0; j < jobList.size (); j++)
+    {
+      const Job &job = jobList[j];
+      std::ifstream in ((job.directory + "/run.csv").c_str ());
+      if (!succeeded[j] || !in.is_open ())
+        {
+          failed++;
+          continue;
+        }
+      std::string line;
+      if (std::getline (in, line) && !header)
+        {
+          out << "run";
+          for (uint32_t i = 0; i < names.size (); i++)
+            {
+              out << ',' << names[i];
+            }
+          out << ',' << line << '\n';
+          header = true;
+        }
+      while (std::getline (in, line))
+        {
+          out << job.run;
+          for (uint32_t i = 0; i < job.values.size (); i++)
+            {
+              out << ',' << job.values[i];
+            }
+          out << ',' << line << '\n';
+        }
+    }
+  std::cerr << jobList.size () - failed << " of " << jobList.size () << " runs merged into " << output << std::endl;
+  return failed > 0 ? 1 : 0;
+}
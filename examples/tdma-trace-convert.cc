@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Converts a binary trace written by TdmaHelper::EnableBinaryTrace to text,
+ * with one line per record in the format of the ascii traces:
+ *   <event> <time (s)> /NodeList/<node> uid <uid> size <size>
+ *
+ * ./waf --run "tdma-trace-convert --input=tdma.bin --output=tdma.txt"
+ */
+#include "ns3/core-module.h"
+#include "ns3/simple-wireless-tdma-module.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+int main (int argc, char **argv)
+{
+  std::string input = "tdma.bin";
+  std::string output = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary trace file [Default:tdma.bin]", input);
+  cmd.AddValue ("output", "Text file to write, standard output if empty", output);
+  cmd.Parse (argc, argv);
+
+  FILE *in = std::fopen (input.c_str (), "rb");
+  if (in == 0)
+    {
+      std::cerr << "Couldn't open " << input << std::endl;
+      return 1;
+    }
+  TdmaBinaryTraceHeader header;
+  if (std::fread (&header, sizeof (header), 1, in) != 1
+      || std::memcmp (header.magic, "TDMT", sizeof (header.magic)) != 0
+      || header.version != 1)
+    {
+      std::cerr << input << " is not a TDMA binary trace" << std::endl;
+      std::fclose (in);
+      return 1;
+    }
+  std::ofstream file;
+  if (!output.empty ())
+    {
+      file.open (output.c_str ());
+    }
+  std::ostream &os = output.empty () ? std::cout : file;
+
+  const size_t blockRecords = 32768;
+  std::vector<TdmaBinaryTraceRecord> records (blockRecords);
+  size_t n;
+  while ((n = std::fread (&records[0], sizeof (TdmaBinaryTraceRecord), blockRecords, in)) > 0)
+    {
+      for (size_t i = 0; i < n; i++)
+        {
+          const TdmaBinaryTraceRecord &r = records[i];
+          os << static_cast<char> (r.event) << ' ' << NanoSeconds (r.time).GetSeconds ()
+             << " /NodeList/" << r.nodeId << " uid " << r.uid << " size " << r.size << '\n';
+        }
+    }
+  std::fclose (in);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-binary-trace.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE ("TdmaBinaryTraceWriter");
+
+namespace ns3 {
+
+TdmaBinaryTraceWriter::TdmaBinaryTraceWriter (std::string fileName)
+  : m_fileName (fileName),
+    m_file (0),
+    m_buffer (1 << 20),
+    m_used (0)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  m_file = std::fopen (fileName.c_str (), "wb");
+  NS_ABORT_MSG_IF (m_file == 0, "Couldn't open the file " << fileName);
+  // records are buffered here, the stdio buffer would only add a copy
+  std::setvbuf (m_file, 0, _IONBF, 0);
+  TdmaBinaryTraceHeader header;
+  std::memcpy (header.magic, "TDMT", sizeof (header.magic));
+  header.version = 1;
+  std::memcpy (&m_buffer[0], &header, sizeof (header));
+  m_used = sizeof (header);
+}
+
+TdmaBinaryTraceWriter::~TdmaBinaryTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  std::fclose (m_file);
+}
+
+void
+TdmaBinaryTraceWriter::Write (uint8_t event, uint32_t nodeId, Ptr<const Packet> packet)
+{
+  if (m_used + sizeof (TdmaBinaryTraceRecord) > m_buffer.size ())
+    {
+      Flush ();
+    }
+  TdmaBinaryTraceRecord record;
+  record.time = Simulator::Now ().GetNanoSeconds ();
+  record.uid = packet->GetUid ();
+  record.nodeId = nodeId;
+  record.size = packet->GetSize ();
+  record.event = event;
+  std::memset (record.reserved, 0, sizeof (record.reserved));
+  std::memcpy (&m_buffer[m_used], &record, sizeof (record));
+  m_used += sizeof (record);
+}
+
+void
+TdmaBinaryTraceWriter::Flush (void)
+{
+  NS_LOG_FUNCTION (this << m_used);
+  if (m_used > 0)
+    {
+      NS_ABORT_MSG_IF (std::fwrite (&m_buffer[0], 1, m_used, m_file) != m_used,
+                       "Couldn't write the file " << m_fileName);
+      m_used = 0;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_BINARY_TRACE_H
+#define TDMA_BINARY_TRACE_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/packet.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace ns3 {
+
+/**
+ * \brief writes mac events as fixed size binary records
+ *
+ * The file starts with a TdmaBinaryTraceHeader followed by one
+ * TdmaBinaryTraceRecord per event, in host byte order. Records are
+ * gathered in a 1 MiB buffer and written in blocks, and packets are not
+ * printed, so packet metadata need not be enabled. The tdma-trace-convert
+ * program turns a file into text.
+ */
+class TdmaBinaryTraceWriter : public SimpleRefCount<TdmaBinaryTraceWriter>
+{
+public:
+  /**
+   * \param fileName file to create
+   */
+  TdmaBinaryTraceWriter (std::string fileName);
+  ~TdmaBinaryTraceWriter ();
+
+  enum Event
+  {
+    TX = 't',
+    RX = 'r',
+    DROP = 'd'
+  };
+
+  /**
+   * \param event kind of event
+   * \param nodeId node the event happened on
+   * \param packet packet of the event
+   */
+  void Write (uint8_t event, uint32_t nodeId, Ptr<const Packet> packet);
+  /**
+   * Write the buffered records to the file
+   */
+  void Flush (void);
+
+private:
+  std::string m_fileName;
+  FILE *m_file;
+  std::vector<char> m_buffer;
+  size_t m_used;
+};
+
+struct TdmaBinaryTraceHeader
+{
+  char magic[4]; //!< "TDMT"
+  uint32_t version; //!< 1
+};
+
+struct TdmaBinaryTraceRecord
+{
+  int64_t time; //!< ns
+  uint64_t uid; //!< packet uid
+  uint32_t nodeId;
+  uint32_t size; //!< bytes
+  uint8_t event; //!< TdmaBinaryTraceWriter::Event
+  uint8_t reserved[7];
+};
+
+} // namespace ns3
+
+#endif /* TDMA_BINARY_TRACE_H */
@@ -31,12 +31,28 @@
 #include "tdma-helper.h"
 #include "ns3/tdma-mac-net-device.h"
 #include "ns3/simple-wireless-channel.h"
+#ifdef TDMA_MPI
+#include "ns3/simple-wireless-remote-channel.h"
+#include "ns3/point-to-point-helper.h"
+#endif
+#include "ns3/tdma-slot-scheduler.h"
 #include "ns3/channel.h"
 #include "ns3/mobility-model.h"
 #include "ns3/log.h"
 #include "ns3/config.h"
 #include "ns3/simulator.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
+#include "ns3/abort.h"
+#include "ns3/tdma-schedule-file.h"
+#include "ns3/tdma-central-mac.h"
+#include "tdma-binary-trace.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/arp-cache.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
 
 NS_LOG_COMPONENT_DEFINE ("TdmaHelper");
 
@@ -46,69 +62,114 @@ static void AsciiMacTxEventWithContext (Ptr<OutputStreamWrapper> stream, std::st
                                         Ptr<const Packet> packet)
 {
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << context << " "
-                        << *packet << std::endl;
+                        << *packet << '\n';
 }
 
 static void AsciiMacRxOkEventWithContext (Ptr<OutputStreamWrapper> stream, std::string context,
                                           Ptr<const Packet> packet)
 {
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " "
-                        << *packet << std::endl;
+                        << *packet << '\n';
 }
 
 static void AsciiMacTxDropEventWithContext (Ptr<OutputStreamWrapper> stream, std::string context,
                                             Ptr<const Packet> packet)
 {
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << " "
-                        << *packet << std::endl;
+                        << *packet << '\n';
 }
 
 static void AsciiMacTxEventWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> packet)
 {
-  *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
+  *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << *packet << '\n';
 }
 
 static void AsciiMacRxOkEventWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> packet)
 {
-  *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
+  *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *packet << '\n';
 }
 
 static void AsciiMacTxDropEventWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> packet)
 {
-  *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *packet << std::endl;
+  *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *packet << '\n';
+}
+
+const uint32_t TdmaHelper::NO_OWNER;
+const uint32_t TdmaHelper::MAX_CHANNELS;
+
+static void BinaryMacTxEvent (Ptr<TdmaBinaryTraceWriter> writer, uint32_t nodeId, Ptr<const Packet> packet)
+{
+  writer->Write (TdmaBinaryTraceWriter::TX, nodeId, packet);
+}
+
+static void BinaryMacRxOkEvent (Ptr<TdmaBinaryTraceWriter> writer, uint32_t nodeId, Ptr<const Packet> packet)
+{
+  writer->Write (TdmaBinaryTraceWriter::RX, nodeId, packet);
+}
+
+static void BinaryMacTxDropEvent (Ptr<TdmaBinaryTraceWriter> writer, uint32_t nodeId, Ptr<const Packet> packet)
+{
+  writer->Write (TdmaBinaryTraceWriter::DROP, nodeId, packet);
+}
+
+static void PrintStats (std::string fileName, NetDeviceContainer devices)
+{
+  std::ofstream file;
+  if (!fileName.empty ())
+    {
+      file.open (fileName.c_str ());
+      NS_ABORT_MSG_UNLESS (file.is_open (), "Couldn't open the file " << fileName);
+    }
+  std::ostream &os = fileName.empty () ? std::cout : file;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<TdmaNetDevice> device = (*i)->GetObject<TdmaNetDevice> ();
+      Ptr<TdmaCentralMac> mac = DynamicCast<TdmaCentralMac> (device->GetMac ());
+      os << "node " << device->GetNode ()->GetId () << '\n';
+      mac->GetStats ()->Print (os);
+    }
 }
 
 TdmaHelper::TdmaHelper (uint32_t numNodes, uint32_t numSlots) : m_controller (0),
                                                                 m_controllerHelper (0),
-                                                                m_slotAllotmentArray (0),
-                                                                m_numRows (numNodes),
-                                                                m_numCols (numSlots + 1)
+                                                                m_numNodes (numNodes),
+                                                                m_numSlots (numSlots),
+                                                                m_numChannels (1),
+                                                                m_indexed (false)
 {
   NS_LOG_FUNCTION (this << numNodes << numSlots);
   m_mac.SetTypeId ("ns3::TdmaCentralMac");
   m_channel = CreateObject<SimpleWirelessChannel> ();
-  Allocate2D ();
+  ClearSlots ();
   SetDefaultSlots ();
 }
 
 TdmaHelper::TdmaHelper (std::string filename) : m_controller (0),
                                                 m_controllerHelper (0),
-                                                m_slotAllotmentArray (0),
-                                                m_filename (filename)
+                                                m_numChannels (1),
+                                                m_filename (filename),
+                                                m_indexed (false)
 {
   m_mac.SetTypeId ("ns3::TdmaCentralMac");
   m_channel = CreateObject<SimpleWirelessChannel> ();
+  if (TdmaScheduleFile::IsScheduleFile (m_filename))
+    {
+      // binary schedules are used in place by the controller
+      m_scheduleFile = CreateObject<TdmaScheduleFile> (m_filename);
+      m_numNodes = 0;
+      m_numSlots = m_scheduleFile->GetNumSlots ();
+      return;
+    }
   m_parser = CreateObject<TdmaSlotAssignmentFileParser> (m_filename);
-  m_numRows = m_parser->GetNodeCount ();
-  m_numCols = m_parser->GetTotalSlots () + 1; // +1 for nodeid in first column
-  Allocate2D ();
+  m_numNodes = m_parser->GetNodeCount ();
+  m_numSlots = m_parser->GetTotalSlots ();
+  ClearSlots ();
   SetSlots ();
 }
 
 TdmaHelper::~TdmaHelper ()
 {
   NS_LOG_FUNCTION (this);
-  Deallocate2D ();
 }
 
 void
@@ -124,62 +185,79 @@ TdmaHelper::SetTdmaControllerHelper (const TdmaControllerHelper &controllerHelpe
   delete m_controllerHelper;
   m_controllerHelper = controllerHelper.Copy ();
   m_controller = m_controllerHelper->Create ();
-  m_controller->SetTotalSlotsAllowed (m_numCols - 1);
-}
-
-void TdmaHelper::Deallocate2D (void)
-{
-  for (uint32_t i = 0; i < m_numRows; i++)
+  m_controller->SetTotalSlotsAllowed (m_numSlots);
+  if (m_parser != 0 && m_parser->GetHoppingChannels () > 0)
     {
-      free (m_slotAllotmentArray[i]);
+      m_controller->SetAttribute ("NumChannels", UintegerValue (m_parser->GetHoppingChannels ()));
+      m_controller->SetChannelHopping (true);
+    }
+  if (m_scheduleFile != 0)
+    {
+      m_controller->SetScheduleFile (m_scheduleFile);
     }
-  free (m_slotAllotmentArray);
 }
 
-void TdmaHelper::Allocate2D (void)
+void
+TdmaHelper::ClearSlots (void)
 {
   NS_LOG_FUNCTION (this);
-  m_slotAllotmentArray = (uint32_t**)malloc (m_numRows * sizeof(int*));
-  for (uint32_t i = 0; i < m_numRows; i++)
+  m_numChannels = 1;
+  m_slotOwners.assign (m_numSlots, NO_OWNER);
+  m_listenSlots.clear ();
+  m_indexed = false;
+}
+
+void
+TdmaHelper::WidenChannels (uint32_t numChannels)
+{
+  NS_LOG_FUNCTION (this << numChannels);
+  if (numChannels <= m_numChannels)
     {
-      m_slotAllotmentArray[i] = (uint32_t*)malloc (m_numCols * sizeof(int));
+      return;
     }
-  for (uint32_t i = 0; i < m_numRows; i++)
+  NS_ABORT_MSG_IF (numChannels > MAX_CHANNELS, "Channel number " << numChannels - 1
+                                                                  << " beyond the " << MAX_CHANNELS << " channels supported");
+  std::vector<uint32_t> owners (uint64_t (m_numSlots) * numChannels, NO_OWNER);
+  for (uint64_t i = 0; i < m_numSlots; i++)
     {
-      m_slotAllotmentArray[i][0] = i; //put in nodeId
-      for (uint32_t j = 1; j < m_numCols; j++)
-        {
-          m_slotAllotmentArray[i][j] = 0;
-        }
+      std::copy (m_slotOwners.begin () + i * m_numChannels,
+                 m_slotOwners.begin () + (i + 1) * m_numChannels,
+                 owners.begin () + i * numChannels);
     }
+  m_slotOwners.swap (owners);
+  m_numChannels = numChannels;
+}
+
+void
+TdmaHelper::AssignSlot (uint32_t nodeId, uint32_t slot, uint16_t channelNumber)
+{
+  NS_ASSERT_MSG (slot < m_numSlots, "Slot " << slot << " is beyond the " << m_numSlots << " slots of the frame");
+  WidenChannels (uint32_t (channelNumber) + 1);
+  uint32_t &owner = m_slotOwners[uint64_t (slot) * m_numChannels + channelNumber];
+  NS_ASSERT_MSG (owner == NO_OWNER || owner == nodeId, "Slot exclusivity is not maintained");
+  owner = nodeId;
+  m_indexed = false;
 }
 
 void
 TdmaHelper::SetDefaultSlots (void)
 {
   NS_LOG_FUNCTION (this);
-  //PrintSlotAllotmentArray ();
-  int continuousSlots = (m_numCols - 1) / m_numRows;
-  for (uint32_t i = 0; i < m_numRows; i++)
+  uint32_t continuousSlots = m_numSlots / m_numNodes;
+  for (uint32_t i = 0; i < m_numNodes; i++)
     {
       NS_LOG_DEBUG ("i:" << i << " continuousSlots:" << continuousSlots
-                         << " m_numRows:" << m_numRows << " m_numCols:" << m_numCols);
-      int tmp = 0;
-      while (tmp < continuousSlots)
+                         << " m_numNodes:" << m_numNodes << " m_numSlots:" << m_numSlots);
+      for (uint32_t tmp = 0; tmp < continuousSlots; tmp++)
         {
-          tmp++;
-          if (continuousSlots * i + tmp > m_numCols)
-            {
-              break;
-            }
-          m_slotAllotmentArray[i][continuousSlots * i + tmp] = 1;
+          AssignSlot (i, continuousSlots * i + tmp, 0);
         }
     }
-  uint32_t remainingSlots = m_numCols - 1 - (continuousSlots * m_numRows);
+  uint32_t remainingSlots = m_numSlots - (continuousSlots * m_numNodes);
   NS_LOG_DEBUG ("remainingSlots:" << remainingSlots);
   for (uint32_t i = 0; i < remainingSlots; i++)
     {
-      m_slotAllotmentArray[i][continuousSlots * m_numRows + i + 1] = 1;
+      AssignSlot (i, continuousSlots * m_numNodes + i, 0);
     }
   PrintSlotAllotmentArray ();
 }
@@ -187,17 +265,31 @@ TdmaHelper::SetDefaultSlots (void)
 void
 TdmaHelper::SetSlots (void)
 {
-  //PrintSlotAllotmentArray();
-  std::vector<SlotArray> & slotArrays = m_parser->GetSlotArrays ();
-  for (uint32_t i = 0; i < m_numRows; i++)
+  const TdmaSlotAssignmentFileParser::AssignmentList &assignments = m_parser->GetAssignments ();
+  // widen the slots once to the highest channel number of the file
+  uint32_t numChannels = 1;
+  for (TdmaSlotAssignmentFileParser::AssignmentList::const_iterator i = assignments.begin ();
+       i != assignments.end (); ++i)
     {
-      m_slotAllotmentArray[i][0] = slotArrays[i][0]; //put in nodeId
-      for (uint32_t j = 1; j < m_numCols; j++)
+      if (!i->listen)
         {
-          m_slotAllotmentArray[i][j] = slotArrays[i][j];
+          numChannels = std::max (numChannels, uint32_t (i->channelNumber) + 1);
         }
     }
-  PrintSlotAllotmentArray();
+  WidenChannels (numChannels);
+  for (TdmaSlotAssignmentFileParser::AssignmentList::const_iterator i = assignments.begin ();
+       i != assignments.end (); ++i)
+    {
+      if (i->listen)
+        {
+          SetListenSlot (i->nodeId, i->slot, i->channelNumber);
+        }
+      else
+        {
+          AssignSlot (i->nodeId, i->slot, i->channelNumber);
+        }
+    }
+  PrintSlotAllotmentArray ();
 }
 
 void
@@ -206,65 +298,143 @@ TdmaHelper::SetSlots (int numNodes, ...)
   NS_LOG_FUNCTION (this);
   va_list args;
   va_start (args, numNodes);
-  NS_LOG_DEBUG ("Rows:" << m_numRows << " columns: " << m_numCols);
-  for (uint32_t i = 0; i < m_numRows; i++)
+  NS_LOG_DEBUG ("Nodes:" << m_numNodes << " slots: " << m_numSlots);
+  ClearSlots ();
+  for (uint32_t i = 0; i < m_numNodes; i++)
     {
-      NS_LOG_DEBUG ("new row");
-      m_slotAllotmentArray[i][0] = va_arg (args, int);
-      for (uint32_t j = 1; j < m_numCols; j++)
+      uint32_t nodeId = va_arg (args, int);
+      for (uint32_t j = 0; j < m_numSlots; j++)
         {
-          NS_LOG_DEBUG ("new column");
-          NS_LOG_DEBUG ("before: value at i: " << i << " j: " << j << " is " << m_slotAllotmentArray[i][j]);
-          m_slotAllotmentArray[i][j] = va_arg (args, int);
-          NS_LOG_DEBUG ("after: value at i: " << i << " j: " << j << " is " << m_slotAllotmentArray[i][j]);
+          uint32_t value = va_arg (args, int);
+          NS_LOG_DEBUG ("value at node: " << nodeId << " slot: " << j << " is " << value);
+          if (value != 0)
+            {
+              NS_ABORT_MSG_IF (value > MAX_CHANNELS,
+                               "Tdma slots should be assigned with 0 or a channel number plus one, up to "
+                               << MAX_CHANNELS);
+              AssignSlot (nodeId, j, value - 1);
+            }
         }
     }
   va_end (args);
-  NS_LOG_DEBUG ("Rows:" << m_numRows << " columns: " << m_numCols);
-  //PrintSlotAllotmentArray();
+}
+
+void
+TdmaHelper::IndexSlots (void) const
+{
+  NS_LOG_FUNCTION (this);
+  m_nodeSlots.clear ();
+  for (uint64_t i = 0; i < m_slotOwners.size (); i++)
+    {
+      uint32_t nodeId = m_slotOwners[i];
+      if (nodeId == NO_OWNER)
+        {
+          continue;
+        }
+      if (nodeId >= m_nodeSlots.size ())
+        {
+          m_nodeSlots.resize (nodeId + 1);
+        }
+      m_nodeSlots[nodeId].push_back (i);
+    }
+  m_indexed = true;
 }
 
 void
 TdmaHelper::AssignTdmaSlots (Ptr<TdmaMac> mac, uint32_t nodeId) const
 {
   NS_LOG_FUNCTION (this << mac << nodeId);
-  for (uint32_t i = 0; i < m_numRows; i++)
+  if (!m_indexed)
+    {
+      IndexSlots ();
+    }
+  if (nodeId >= m_nodeSlots.size () || m_nodeSlots[nodeId].empty ())
+    {
+      NS_LOG_WARN ("No slots assigned to node " << nodeId);
+      return;
+    }
+  const std::vector<uint64_t> &cells = m_nodeSlots[nodeId];
+  for (std::vector<uint64_t>::const_iterator i = cells.begin (); i != cells.end (); ++i)
+    {
+      m_controller->AddTdmaSlot (*i / m_numChannels, *i % m_numChannels, mac);
+    }
+}
+
+void
+TdmaHelper::WriteScheduleFile (std::string fileName) const
+{
+  NS_LOG_FUNCTION (this << fileName);
+  NS_ABORT_MSG_IF (m_scheduleFile != 0, "The schedule already comes from a binary file");
+  Time slotTime;
+  Time guardTime;
+  Time interFrameTime;
+  if (m_controller != 0)
+    {
+      slotTime = m_controller->GetSlotTime ();
+      guardTime = m_controller->GetGuardTime ();
+      interFrameTime = m_controller->GetInterFrameTimeInterval ();
+    }
+  TdmaScheduleFile::Write (fileName, m_numSlots, m_numChannels, slotTime, guardTime, interFrameTime, m_slotOwners);
+}
+
+Ptr<TdmaController>
+TdmaHelper::GetTdmaController (void) const
+{
+  return m_controller;
+}
+
+void
+TdmaHelper::SetScheduleGenerator (Ptr<TdmaScheduleGenerator> generator)
+{
+  NS_LOG_FUNCTION (this << generator);
+  NS_ABORT_MSG_IF (m_scheduleFile != 0, "The schedule already comes from a binary file");
+  NS_ABORT_MSG_IF (m_numNodes == 0, "Schedule generators need the number of nodes");
+  std::vector<uint32_t> owners = generator->Generate (m_numNodes, m_numSlots);
+  NS_ASSERT (owners.size () == m_numSlots);
+  ClearSlots ();
+  for (uint32_t i = 0; i < m_numSlots; i++)
     {
-      if (m_slotAllotmentArray[i][0] == nodeId)
+      if (owners[i] != TdmaScheduleGenerator::NO_OWNER)
         {
-          for (uint32_t j = 1; j < m_numCols; j++)
-            {
-              //validation of the slots
-              NS_ASSERT_MSG (((m_slotAllotmentArray[i][j] == 0) || (m_slotAllotmentArray[i][j] == 1)),
-                             "Tdma slots should be assigned with only 0 or 1");
-              for (uint32_t k = 0; k < m_numRows; k++)
-                {
-                  if (k == i)
-                    {
-                      continue;
-                    }
-                  NS_ASSERT_MSG (!(m_slotAllotmentArray[k][j] == 1 && m_slotAllotmentArray[i][j] == 1),
-                                 "Slot exclusivity is not maintained");
-                }
-              if (m_slotAllotmentArray[i][j] == 1)
-                {
-                  m_controller->AddTdmaSlot (j - 1,mac);
-                }
-            }
+          AssignSlot (owners[i], i, 0);
         }
     }
+  PrintSlotAllotmentArray ();
+}
+
+void
+TdmaHelper::SetChannelNumber (uint32_t nodeId, uint16_t channelNumber)
+{
+  NS_LOG_FUNCTION (this << nodeId << channelNumber);
+  m_channelNumbers[nodeId] = channelNumber;
+}
+
+void
+TdmaHelper::SetListenSlot (uint32_t nodeId, uint32_t slot, uint16_t channelNumber)
+{
+  NS_LOG_FUNCTION (this << nodeId << slot << channelNumber);
+  NS_ASSERT_MSG (slot < m_numSlots, "Slot " << slot << " is beyond the " << m_numSlots << " slots of the frame");
+  m_listenSlots[nodeId].push_back (std::make_pair (slot, channelNumber));
 }
 
 void
 TdmaHelper::PrintSlotAllotmentArray (void) const
 {
+  if (!g_log.IsEnabled (LOG_DEBUG))
+    {
+      return;
+    }
   std::cout << "Printing SlotAllotmentArray\n";
-  for (uint32_t i = 0; i < m_numRows; i++)
+  for (uint32_t i = 0; i < m_numSlots; i++)
     {
-      std::cout << m_slotAllotmentArray[i][0] << " : \t";
-      for (uint32_t j = 1; j < m_numCols; j++)
+      std::cout << i << " : \t";
+      for (uint32_t j = 0; j < m_numChannels; j++)
         {
-          std::cout << m_slotAllotmentArray[i][j] << ",\t";
+          uint32_t owner = m_slotOwners[uint64_t (i) * m_numChannels + j];
+          if (owner != NO_OWNER)
+            {
+              std::cout << owner << "@" << j << ",\t";
+            }
         }
       std::cout << "\n";
     }
@@ -282,7 +452,28 @@ TdmaHelper::Install (NodeContainer c) const
       Ptr<TdmaNetDevice> device = CreateObject<TdmaNetDevice> ();
       Ptr<TdmaMac> mac = m_mac.Create<TdmaMac> ();
       mac->SetAddress (Mac48Address::Allocate ());
-      AssignTdmaSlots (mac,node->GetId ());
+      if (m_scheduleFile != 0)
+        {
+          m_controller->AddTdmaMac (node->GetId (), mac);
+        }
+      else
+        {
+          AssignTdmaSlots (mac,node->GetId ());
+        }
+      std::map<uint32_t, uint16_t>::const_iterator ch = m_channelNumbers.find (node->GetId ());
+      if (ch != m_channelNumbers.end ())
+        {
+          mac->SetChannelNumber (ch->second);
+        }
+      std::map<uint32_t, std::vector<std::pair<uint32_t, uint16_t> > >::const_iterator listen = m_listenSlots.find (node->GetId ());
+      if (listen != m_listenSlots.end ())
+        {
+          for (std::vector<std::pair<uint32_t, uint16_t> >::const_iterator j = listen->second.begin ();
+               j != listen->second.end (); ++j)
+            {
+              m_controller->AddListenSlot (j->first, j->second, mac);
+            }
+        }
       device->SetMac (mac);
       device->SetChannel (m_channel);
       device->SetTdmaController (m_controller);
@@ -320,6 +511,176 @@ TdmaHelper::EnableLogComponents (void)
   LogComponentEnable ("SimpleWirelessChannel", LOG_LEVEL_ALL);
 }
 
+void
+TdmaHelper::EnableBinaryTrace (std::string fileName, NetDeviceContainer devices)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  Ptr<TdmaBinaryTraceWriter> writer = Create<TdmaBinaryTraceWriter> (fileName);
+  Simulator::ScheduleDestroy (&TdmaBinaryTraceWriter::Flush, writer);
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<TdmaNetDevice> device = (*i)->GetObject<TdmaNetDevice> ();
+      if (device == 0)
+        {
+          NS_LOG_INFO ("TdmaHelper::EnableBinaryTrace(): Device " << *i << " not of type ns3::TdmaNetDevice");
+          continue;
+        }
+      uint32_t nodeId = device->GetNode ()->GetId ();
+      Ptr<TdmaMac> mac = device->GetMac ();
+      mac->TraceConnectWithoutContext ("MacTx", MakeBoundCallback (&BinaryMacTxEvent, writer, nodeId));
+      mac->TraceConnectWithoutContext ("MacRx", MakeBoundCallback (&BinaryMacRxOkEvent, writer, nodeId));
+      mac->TraceConnectWithoutContext ("MacTxDrop", MakeBoundCallback (&BinaryMacTxDropEvent, writer, nodeId));
+    }
+}
+
+void
+TdmaHelper::EnableStats (std::string fileName, NetDeviceContainer devices)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  NetDeviceContainer traced;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<TdmaNetDevice> device = (*i)->GetObject<TdmaNetDevice> ();
+      Ptr<TdmaCentralMac> mac = device != 0 ? DynamicCast<TdmaCentralMac> (device->GetMac ()) : Ptr<TdmaCentralMac> ();
+      if (mac == 0)
+        {
+          NS_LOG_INFO ("TdmaHelper::EnableStats(): Device " << *i << " has no ns3::TdmaCentralMac");
+          continue;
+        }
+      if (mac->GetStats () == 0)
+        {
+          mac->SetStats (CreateObject<TdmaMacStats> ());
+        }
+      traced.Add (device);
+    }
+  Simulator::ScheduleDestroy (&PrintStats, fileName, traced);
+}
+
+void
+TdmaHelper::PopulateArpCaches (NetDeviceContainer devices)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<std::pair<Ipv4Address, Address> > addresses;
+  std::vector<Ptr<Ipv4Interface> > interfaces;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<Ipv4L3Protocol> ipv4 = (*i)->GetNode ()->GetObject<Ipv4L3Protocol> ();
+      int32_t interface = ipv4 != 0 ? ipv4->GetInterfaceForDevice (*i) : -1;
+      if (interface < 0 || ipv4->GetNAddresses (interface) == 0)
+        {
+          NS_LOG_INFO ("TdmaHelper::PopulateArpCaches(): Device " << *i << " has no IPv4 address");
+          continue;
+        }
+      for (uint32_t j = 0; j < ipv4->GetNAddresses (interface); j++)
+        {
+          addresses.push_back (std::make_pair (ipv4->GetAddress (interface, j).GetLocal (), (*i)->GetAddress ()));
+        }
+      interfaces.push_back (ipv4->GetInterface (interface));
+    }
+  // fill the cache of every interface, which keeps its device for the
+  // addresses that are not in devices, with entries that never expire
+  for (std::vector<Ptr<Ipv4Interface> >::iterator i = interfaces.begin (); i != interfaces.end (); ++i)
+    {
+      Ptr<ArpCache> arp = (*i)->GetArpCache ();
+      arp->SetAliveTimeout (Seconds (3600 * 24 * 365));
+      for (std::vector<std::pair<Ipv4Address, Address> >::const_iterator j = addresses.begin ();
+           j != addresses.end (); ++j)
+        {
+          if (arp->Lookup (j->first) != 0)
+            {
+              continue;
+            }
+          ArpCache::Entry *entry = arp->Add (j->first);
+          entry->MarkWaitReply (0);
+          entry->MarkAlive (j->second);
+        }
+    }
+}
+
+#ifdef TDMA_MPI
+void
+TdmaHelper::EnableDistributed (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_channel->GetNDevices () > 0, "TdmaHelper::EnableDistributed() must be called before Install");
+  m_channel = CreateObject<SimpleWirelessRemoteChannel> ();
+}
+
+NetDeviceContainer
+TdmaHelper::InstallLookaheadLinks (NodeContainer nodes) const
+{
+  NS_LOG_FUNCTION (this);
+  NetDeviceContainer devices;
+  Ptr<SimpleWirelessRemoteChannel> channel = DynamicCast<SimpleWirelessRemoteChannel> (m_channel);
+  NS_ABORT_MSG_IF (channel == 0, "TdmaHelper::InstallLookaheadLinks() requires EnableDistributed()");
+  NS_ASSERT (m_controller != 0);
+  Time lookahead = channel->GetLookahead (m_controller);
+  NS_LOG_INFO ("Lookahead " << lookahead);
+  // first node of every rank
+  std::map<uint32_t, Ptr<Node> > ranks;
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      ranks.insert (std::make_pair ((*i)->GetSystemId (), *i));
+    }
+  if (ranks.size () < 2)
+    {
+      return devices;
+    }
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", TimeValue (lookahead));
+  std::map<uint32_t, Ptr<Node> >::const_iterator first = ranks.begin ();
+  for (std::map<uint32_t, Ptr<Node> >::const_iterator i = ++ranks.begin (); i != ranks.end (); ++i)
+    {
+      devices.Add (p2p.Install (first->second, i->second));
+    }
+  return devices;
+}
+#endif /* TDMA_MPI */
+
+void
+TdmaHelper::EnableSlotScheduler (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_controller == 0, "TdmaHelper::EnableSlotScheduler() requires a TdmaController");
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::TdmaSlotScheduler");
+  factory.Set ("BucketWidth", TimeValue (m_controller->GetSlotTime ()));
+  Simulator::SetScheduler (factory);
+}
+
+void
+TdmaHelper::EnablePcapInternal (std::string prefix, Ptr<NetDevice> nd, bool promiscuous, bool explicitFilename)
+{
+  Ptr<TdmaNetDevice> device = nd->GetObject<TdmaNetDevice> ();
+  if (device == 0)
+    {
+      NS_LOG_INFO ("TdmaHelper::EnablePcapInternal(): Device " << device << " not of type ns3::TdmaNetDevice");
+      return;
+    }
+
+  PcapHelper pcapHelper;
+
+  std::string filename;
+  if (explicitFilename)
+    {
+      filename = prefix;
+    }
+  else
+    {
+      filename = pcapHelper.GetFilenameFromDevice (prefix, device);
+    }
+
+  Ptr<PcapFileWrapper> file = pcapHelper.CreateFile (filename, std::ios::out, PcapHelper::DLT_IEEE802_11);
+  if (promiscuous)
+    {
+      pcapHelper.HookDefaultSink<TdmaMac> (device->GetMac (), "PromiscSniffer", file);
+    }
+  else
+    {
+      pcapHelper.HookDefaultSink<TdmaMac> (device->GetMac (), "Sniffer", file);
+    }
+}
+
 void
 TdmaHelper::EnableAsciiInternal (
   Ptr<OutputStreamWrapper> stream,
@@ -33,6 +33,8 @@
 
 #include <string>
 #include <stdarg.h>
+#include <map>
+#include <vector>
 #include "ns3/attribute.h"
 #include "ns3/tdma-mac.h"
 #include "ns3/object-factory.h"
@@ -41,6 +43,8 @@
 #include "ns3/trace-helper.h"
 #include "ns3/tdma-controller-helper.h"
 #include "tdma-slot-assignment-parser.h"
+#include "ns3/tdma-schedule-file.h"
+#include "tdma-schedule-generator.h"
 
 namespace ns3 {
 
@@ -72,7 +76,8 @@ public:
  * \brief helps to create TdmaNetDevice objects and ensures creation of a centralized
  * TdmaController which takes care of the slot scheduling
  */
-class TdmaHelper : public AsciiTraceHelperForDevice
+class TdmaHelper : public PcapHelperForDevice,
+                   public AsciiTraceHelperForDevice
 {
 public:
   /**
@@ -92,6 +97,12 @@ public:
    * 1:0,0,1,0,0
    * 2:0,0,0,1,0
    * 3:0,0,0,0,1
+   * A slot value k greater than 1 assigns the slot on channel number k-1,
+   * letting several nodes transmit in the same slot on different channels.
+   * Text following '#' is ignored, and a line "hopping:16" makes the
+   * channel numbers offsets hopped over 16 physical channels.
+   * Binary schedule files (see TdmaScheduleFile) are recognised by their
+   * magic and used in place by the TdmaController
    */
   TdmaHelper (std::string fileName);
   ~TdmaHelper ();
@@ -118,6 +129,10 @@ public:
    * \brief Set the TdmaController for this TdamHelper class
    */
   void SetTdmaControllerHelper (const TdmaControllerHelper &controllerHelper);
+  /**
+   * \returns the TdmaController created by SetTdmaControllerHelper
+   */
+  Ptr<TdmaController> GetTdmaController (void) const;
   /**
    * \brief used to set the TDMA slots from the simulation script
    * useful for low number of nodes. If the number of nodes is more, it is
@@ -133,11 +148,121 @@ public:
    *               3,0,0,0,0,1);   *
    */
   void SetSlots (int NodeNum, ...);
+  /**
+   * \brief set the channel number a node listens on
+   *
+   * \param nodeId id of the node
+   * \param channelNumber channel number applied to its mac by Install.
+   * Nodes not configured listen on channel number 0.
+   */
+  void SetChannelNumber (uint32_t nodeId, uint16_t channelNumber);
+  /**
+   * \brief tune the receiver of a node to a channel number for one slot
+   *
+   * \param nodeId id of the node
+   * \param slot slot index in the frame
+   * \param channelNumber channel number the node listens on in \p slot,
+   * instead of its own channel number (see SetChannelNumber)
+   */
+  void SetListenSlot (uint32_t nodeId, uint32_t slot, uint16_t channelNumber);
+  /**
+   * \brief replace the slot assignment with the one computed by a
+   * schedule generator, for nodes 0 to numNodes-1
+   *
+   * \param generator for example a TdmaRoundRobinScheduleGenerator
+   */
+  void SetScheduleGenerator (Ptr<TdmaScheduleGenerator> generator);
+  /**
+   * \brief save the slot assignment as a binary schedule file
+   *
+   * \param fileName file to write, which can be passed to the TdmaHelper
+   * constructor of later runs. The slot, guard and inter frame times of the
+   * controller, if already set, are stored along.
+   */
+  void WriteScheduleFile (std::string fileName) const;
   /**
    * Helper to enable all TdmaNetDevice log components with one statement
    */
   static void EnableLogComponents (void);
+  /**
+   * \brief write the MacTx, MacRx and MacTxDrop events of \p devices to
+   * a compact binary trace
+   *
+   * \param fileName file to write, see TdmaBinaryTraceWriter
+   * \param devices devices to trace
+   */
+  void EnableBinaryTrace (std::string fileName, NetDeviceContainer devices);
+  /**
+   * \brief collect TdmaMacStats on \p devices and print them, per node,
+   * when the simulator is destroyed
+   *
+   * \param fileName file to print to, or an empty string for std::cout
+   * \param devices devices to collect statistics on
+   */
+  void EnableStats (std::string fileName, NetDeviceContainer devices);
+  /**
+   * \brief fill the ARP caches of \p devices with the IPv4 and MAC
+   * addresses of every one of them
+   *
+   * Call it once the addresses are assigned. Address resolution is then
+   * answered from the caches, so no ARP frame waits for a slot and the
+   * first packets of a flow are sent at once. The entries are added to
+   * the cache of each interface, whose AliveTimeout is raised to a year,
+   * and other addresses are still resolved with ARP. Devices without an
+   * IPv4 address are skipped.
+   *
+   * \param devices devices created by Install
+   */
+  static void PopulateArpCaches (NetDeviceContainer devices);
+#ifdef TDMA_MPI
+  /**
+   * \brief partition the channel over the ranks of a distributed
+   * simulation, see SimpleWirelessRemoteChannel
+   *
+   * Call it before Install, on every rank, and create every node on
+   * every rank with the system id of the rank it runs on.
+   */
+  void EnableDistributed (void);
+  /**
+   * \brief bound the lookahead of the distributed simulator
+   *
+   * The distributed simulator derives its lookahead from the delays of the
+   * point-to-point links between ranks. This installs, between the first
+   * node of \p nodes on rank 0 and the first node on every other rank, a
+   * point-to-point link whose delay is the lookahead of the channel. The
+   * links carry no traffic. Call it after Install, so the interface indices
+   * of the TDMA devices are the same with and without MPI.
+   *
+   * \param nodes nodes of the simulation, on every rank
+   * \returns the devices of the links installed
+   */
+  NetDeviceContainer InstallLookaheadLinks (NodeContainer nodes) const;
+#endif /* TDMA_MPI */
+  /**
+   * \brief schedule the events of the simulation with a TdmaSlotScheduler
+   * whose buckets are one slot time of the controller wide
+   *
+   * Call it after SetTdmaControllerHelper, before Simulator::Run. Events
+   * already scheduled are moved to the new scheduler.
+   */
+  void EnableSlotScheduler (void) const;
 private:
+  /**
+   * \brief Enable pcap output on the indicated net device.
+   * \internal
+   *
+   * Frames are captured with their 802.11 header and FCS, as put on the
+   * channel by TdmaMacLow, with the IEEE 802.11 link type.
+   *
+   * \param prefix Filename prefix to use for pcap files.
+   * \param nd Net device for which you want to enable tracing.
+   * \param promiscuous If true capture all possible packets available at the device.
+   * \param explicitFilename Treat the prefix as an explicit filename if true
+   */
+  virtual void EnablePcapInternal (std::string prefix,
+                                   Ptr<NetDevice> nd,
+                                   bool promiscuous,
+                                   bool explicitFilename);
   /**
    * \brief Enable ascii trace output on the indicated net device.
    * \internal
@@ -171,15 +296,17 @@ private:
    */
   void SetSlots (void);
   /**
-   *  \brief memory allocation of the m_slotAllotmentArray when number of
-   *  nodes and total number of slots occupied by those nodes is specified
-   *  by the user
+   * \brief unassign every slot
    */
-  void Allocate2D (void);
+  void ClearSlots (void);
   /**
-   * memory deallocation of the m_slotAllotmentArray during object deletion
+   * \brief assign a slot to a node, checking slot exclusivity
+   *
+   * \param nodeId node id the slot is assigned to
+   * \param slot slot index in the frame
+   * \param channelNumber channel number the node transmits on in this slot
    */
-  void Deallocate2D (void);
+  void AssignSlot (uint32_t nodeId, uint32_t slot, uint16_t channelNumber);
   /**
    * \brief Populate the m_slotArray in the TdmaController class with the
    * mac pointers of nodes assigned to those slots
@@ -188,16 +315,35 @@ private:
    * \param nodeId node id assigned to this TDMA slot
    */
   void AssignTdmaSlots (Ptr<TdmaMac> mac, uint32_t nodeId) const;
+  /**
+   * \brief index the slots of every node, in a single pass over the
+   * slot owners
+   */
+  void IndexSlots (void) const;
+  /**
+   * \brief widen every slot of m_slotOwners to \p numChannels channels,
+   * if it has fewer
+   */
+  void WidenChannels (uint32_t numChannels);
+
+  static const uint32_t NO_OWNER = 0xffffffff;
+  static const uint32_t MAX_CHANNELS = 256; //!< channel numbers a schedule may use
 
   ObjectFactory m_mac;
   Ptr<SimpleWirelessChannel> m_channel;
   Ptr<TdmaController> m_controller;
   const TdmaControllerHelper *m_controllerHelper;
-  uint32_t **m_slotAllotmentArray;
-  uint32_t m_numRows;
-  uint32_t m_numCols;
+  uint32_t m_numNodes;
+  uint32_t m_numSlots;
+  uint32_t m_numChannels;
+  std::vector<uint32_t> m_slotOwners; //!< node id owning each (slot, channel), slot major
   std::string m_filename;
+  std::map<uint32_t, uint16_t> m_channelNumbers;
+  std::map<uint32_t, std::vector<std::pair<uint32_t, uint16_t> > > m_listenSlots; //!< (slot, channel number) per node id
+  mutable bool m_indexed;
+  mutable std::vector<std::vector<uint64_t> > m_nodeSlots; //!< indices in m_slotOwners, indexed by node id
   Ptr<TdmaSlotAssignmentFileParser> m_parser;
+  Ptr<TdmaScheduleFile> m_scheduleFile;
 };
 
 } // namespace ns3
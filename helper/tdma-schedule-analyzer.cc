@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-schedule-analyzer.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("TdmaScheduleAnalyzer");
+
+namespace ns3 {
+
+TdmaScheduleAnalyzer::TdmaScheduleAnalyzer (Ptr<TdmaController> controller)
+  : m_controller (controller),
+    m_frameLength (0),
+    m_slotsLength (0)
+{
+  NS_LOG_FUNCTION (this << controller);
+  int64_t slotTime = controller->GetSlotTime ().GetNanoSeconds ();
+  int64_t guardTime = controller->GetGuardTime ().GetNanoSeconds ();
+  uint32_t totalSlots = controller->GetTotalSlotsAllowed ();
+  uint16_t numChannels = controller->GetNumChannels ();
+  int64_t t = 0;
+  for (uint32_t slot = 0; slot < totalSlots; )
+    {
+      uint32_t sessionLength = controller->GetSessionLength (slot);
+      int64_t duration = slotTime * sessionLength;
+      for (uint16_t channelNumber = 0; channelNumber < numChannels; channelNumber++)
+        {
+          Ptr<TdmaMac> owner = controller->GetSlotOwner (slot, channelNumber);
+          if (owner != 0)
+            {
+              Grants &grants = m_grants[owner];
+              grants.start.push_back (t);
+              grants.duration.push_back (duration);
+            }
+        }
+      t += duration + guardTime;
+      m_slotsLength += duration;
+      slot += sessionLength;
+    }
+  m_frameLength = t + controller->GetInterFrameTimeInterval ().GetNanoSeconds ();
+  NS_LOG_DEBUG ("Frame of " << totalSlots << " slots lasts " << m_frameLength << " ns with "
+                            << m_grants.size () << " macs");
+}
+
+Time
+TdmaScheduleAnalyzer::GetFrameLength (void) const
+{
+  return NanoSeconds (m_frameLength);
+}
+
+double
+TdmaScheduleAnalyzer::GetFrameEfficiency (void) const
+{
+  return m_frameLength > 0 ? static_cast<double> (m_slotsLength) / m_frameLength : 0;
+}
+
+uint64_t
+TdmaScheduleAnalyzer::GetCapacity (Ptr<TdmaMac> mac) const
+{
+  GrantMap::const_iterator i = m_grants.find (mac);
+  if (i == m_grants.end ())
+    {
+      return 0;
+    }
+  uint64_t bps = m_controller->GetDataRate ().GetBitRate ();
+  uint64_t bytes = 0;
+  for (std::vector<int64_t>::const_iterator d = i->second.duration.begin (); d != i->second.duration.end (); ++d)
+    {
+      bytes += bps * (*d) / 8000000000ULL;
+    }
+  return bytes;
+}
+
+Time
+TdmaScheduleAnalyzer::GetWorstAccessDelay (Ptr<TdmaMac> mac) const
+{
+  GrantMap::const_iterator i = m_grants.find (mac);
+  if (i == m_grants.end ())
+    {
+      return Time::Max ();
+    }
+  const std::vector<int64_t> &start = i->second.start;
+  // a packet arriving just after a grant started waits for the next one
+  int64_t worst = start.front () + m_frameLength - start.back ();
+  for (uint32_t k = 1; k < start.size (); k++)
+    {
+      worst = std::max (worst, start[k] - start[k - 1]);
+    }
+  return NanoSeconds (worst);
+}
+
+uint32_t
+TdmaScheduleAnalyzer::NextGrant (const Grants &grants, int64_t t, int64_t &wait) const
+{
+  int64_t offset = t % m_frameLength;
+  std::vector<int64_t>::const_iterator it = std::lower_bound (grants.start.begin (), grants.start.end (), offset);
+  if (it == grants.start.end ())
+    {
+      wait = grants.start.front () + m_frameLength - offset;
+      return 0;
+    }
+  wait = *it - offset;
+  return it - grants.start.begin ();
+}
+
+const TdmaScheduleAnalyzer::Grants *
+TdmaScheduleAnalyzer::FindGrants (Mac48Address address) const
+{
+  for (GrantMap::const_iterator i = m_grants.begin (); i != m_grants.end (); ++i)
+    {
+      if (i->first->GetAddress () == address)
+        {
+          return &i->second;
+        }
+    }
+  return 0;
+}
+
+Time
+TdmaScheduleAnalyzer::GetPathLatencyBound (const std::vector<Mac48Address> &path) const
+{
+  NS_LOG_FUNCTION (this << path.size ());
+  if (path.empty ())
+    {
+      return Seconds (0);
+    }
+  std::vector<const Grants *> hops;
+  for (std::vector<Mac48Address>::const_iterator i = path.begin (); i != path.end (); ++i)
+    {
+      const Grants *grants = FindGrants (*i);
+      if (grants == 0)
+        {
+          NS_LOG_WARN ("No slot for " << *i << " on the path");
+          return Time::Max ();
+        }
+      hops.push_back (grants);
+    }
+  // the packet arrives at the source right after a grant started, and is
+  // sent in the source's next grant; try every grant of the source
+  const Grants &source = *hops.front ();
+  int64_t worst = 0;
+  for (uint32_t g = 0; g < source.start.size (); g++)
+    {
+      int64_t previous = (g > 0) ? source.start[g - 1] : source.start.back () - m_frameLength;
+      int64_t t = source.start[g] + source.duration[g];
+      int64_t latency = t - previous;
+      for (uint32_t h = 1; h < hops.size (); h++)
+        {
+          int64_t wait;
+          uint32_t next = NextGrant (*hops[h], t, wait);
+          t += wait + hops[h]->duration[next];
+          latency += wait + hops[h]->duration[next];
+        }
+      worst = std::max (worst, latency);
+    }
+  return NanoSeconds (worst);
+}
+
+void
+TdmaScheduleAnalyzer::Print (std::ostream &os) const
+{
+  os << "frame " << GetFrameLength ().GetMicroSeconds () << " us, efficiency "
+     << GetFrameEfficiency () << '\n';
+  for (GrantMap::const_iterator i = m_grants.begin (); i != m_grants.end (); ++i)
+    {
+      os << i->first->GetAddress () << " grants " << i->second.start.size ()
+         << " capacity " << GetCapacity (i->first) << " B/frame"
+         << " worst access delay " << GetWorstAccessDelay (i->first).GetMicroSeconds () << " us\n";
+    }
+}
+
+} // namespace ns3
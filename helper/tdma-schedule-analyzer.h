@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_SCHEDULE_ANALYZER_H
+#define TDMA_SCHEDULE_ANALYZER_H
+
+#include "ns3/tdma-controller.h"
+#include "ns3/tdma-mac.h"
+#include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
+#include <vector>
+#include <map>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \brief capacity and latency bounds of a TDMA schedule
+ *
+ * Walks the slot map of a TdmaController once, session by session, and
+ * records the grants of every mac: when they start within the frame and
+ * how long they last. All figures are derived from these grants without
+ * running the simulation, so a schedule can be checked before it is
+ * simulated. Capacities assume frames sent back to back at DataRate.
+ */
+class TdmaScheduleAnalyzer
+{
+public:
+  /**
+   * \param controller controller whose macs have been installed
+   */
+  TdmaScheduleAnalyzer (Ptr<TdmaController> controller);
+
+  /**
+   * \returns the duration of a frame, including guard times and the
+   * inter frame time
+   */
+  Time GetFrameLength (void) const;
+  /**
+   * \returns the fraction of the frame spent in slots rather than guard
+   * and inter frame times
+   */
+  double GetFrameEfficiency (void) const;
+  /**
+   * \returns the number of bytes \p mac can send per frame
+   */
+  uint64_t GetCapacity (Ptr<TdmaMac> mac) const;
+  /**
+   * \returns the longest time a packet queued at \p mac can wait for
+   * the start of one of its grants
+   */
+  Time GetWorstAccessDelay (Ptr<TdmaMac> mac) const;
+  /**
+   * \param path addresses of the macs transmitting along a route, from
+   * the source to the last relay
+   * \returns an upper bound of the time from the arrival of a packet at
+   * the source to the end of its last hop, assuming each hop is sent in
+   * the first grant of its transmitter after the previous hop ended and
+   * no queueing behind other packets
+   */
+  Time GetPathLatencyBound (const std::vector<Mac48Address> &path) const;
+  /**
+   * \param os stream to print the per-mac capacity and access delay to
+   */
+  void Print (std::ostream &os) const;
+
+private:
+  struct Grants
+  {
+    std::vector<int64_t> start; //!< ns from the start of the frame, ascending
+    std::vector<int64_t> duration; //!< ns
+  };
+  typedef std::map<Ptr<TdmaMac>, Grants> GrantMap;
+
+  /**
+   * \returns the index of the first grant starting at or after \p t,
+   * wrapping to the next frame, and the wait until its start in \p wait
+   */
+  uint32_t NextGrant (const Grants &grants, int64_t t, int64_t &wait) const;
+  const Grants * FindGrants (Mac48Address address) const;
+
+  Ptr<TdmaController> m_controller;
+  GrantMap m_grants;
+  int64_t m_frameLength; //!< ns
+  int64_t m_slotsLength; //!< ns
+};
+
+} // namespace ns3
+
+#endif /* TDMA_SCHEDULE_ANALYZER_H */
@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-schedule-generator.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include <queue>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+NS_LOG_COMPONENT_DEFINE ("TdmaScheduleGenerator");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (TdmaScheduleGenerator);
+NS_OBJECT_ENSURE_REGISTERED (TdmaRoundRobinScheduleGenerator);
+NS_OBJECT_ENSURE_REGISTERED (TdmaDemandScheduleGenerator);
+NS_OBJECT_ENSURE_REGISTERED (TdmaPathScheduleGenerator);
+
+const uint32_t TdmaScheduleGenerator::NO_OWNER;
+
+TypeId
+TdmaScheduleGenerator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaScheduleGenerator")
+    .SetParent<Object> ();
+  return tid;
+}
+
+TdmaScheduleGenerator::~TdmaScheduleGenerator ()
+{
+}
+
+TypeId
+TdmaRoundRobinScheduleGenerator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaRoundRobinScheduleGenerator")
+    .SetParent<TdmaScheduleGenerator> ()
+    .AddConstructor<TdmaRoundRobinScheduleGenerator> ();
+  return tid;
+}
+
+std::vector<uint32_t>
+TdmaRoundRobinScheduleGenerator::Generate (uint32_t numNodes, uint32_t numSlots) const
+{
+  NS_LOG_FUNCTION (this << numNodes << numSlots);
+  NS_ASSERT (numNodes > 0);
+  std::vector<uint32_t> owners (numSlots);
+  for (uint32_t i = 0; i < numSlots; i++)
+    {
+      owners[i] = i % numNodes;
+    }
+  return owners;
+}
+
+TypeId
+TdmaDemandScheduleGenerator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaDemandScheduleGenerator")
+    .SetParent<TdmaScheduleGenerator> ()
+    .AddConstructor<TdmaDemandScheduleGenerator> ();
+  return tid;
+}
+
+void
+TdmaDemandScheduleGenerator::SetDemand (uint32_t nodeId, double demand)
+{
+  NS_LOG_FUNCTION (this << nodeId << demand);
+  NS_ASSERT_MSG (demand >= 0, "Demands must not be negative");
+  m_demands[nodeId] = demand;
+}
+
+void
+TdmaDemandScheduleGenerator::SetTrafficMatrix (const std::vector<std::vector<double> > &matrix)
+{
+  NS_LOG_FUNCTION (this);
+  m_demands.clear ();
+  for (uint32_t i = 0; i < matrix.size (); i++)
+    {
+      double demand = 0;
+      for (uint32_t j = 0; j < matrix[i].size (); j++)
+        {
+          if (j != i)
+            {
+              demand += matrix[i][j];
+            }
+        }
+      SetDemand (i, demand);
+    }
+}
+
+std::vector<uint32_t>
+TdmaDemandScheduleGenerator::Generate (uint32_t numNodes, uint32_t numSlots) const
+{
+  NS_LOG_FUNCTION (this << numNodes << numSlots);
+  double total = 0;
+  for (std::map<uint32_t, double>::const_iterator i = m_demands.begin (); i != m_demands.end (); ++i)
+    {
+      NS_ASSERT_MSG (i->first < numNodes, "Demand set for node " << i->first << " beyond the " << numNodes << " nodes");
+      total += i->second;
+    }
+  std::vector<uint32_t> owners (numSlots, NO_OWNER);
+  if (total <= 0)
+    {
+      NS_LOG_WARN ("No demand, every slot is idle");
+      return owners;
+    }
+  // largest remainder apportionment of the slots
+  std::vector<uint32_t> counts (numNodes, 0);
+  std::vector<std::pair<double, uint32_t> > remainders;
+  uint32_t allotted = 0;
+  for (std::map<uint32_t, double>::const_iterator i = m_demands.begin (); i != m_demands.end (); ++i)
+    {
+      double quota = numSlots * i->second / total;
+      counts[i->first] = static_cast<uint32_t> (std::floor (quota));
+      allotted += counts[i->first];
+      remainders.push_back (std::make_pair (quota - counts[i->first], i->first));
+    }
+  std::sort (remainders.begin (), remainders.end (), std::greater<std::pair<double, uint32_t> > ());
+  for (uint32_t i = 0; allotted < numSlots && i < remainders.size (); i++, allotted++)
+    {
+      counts[remainders[i].second]++;
+    }
+  // smooth weighted round robin spreads each node's slots over the frame
+  std::vector<int64_t> current (numNodes, 0);
+  for (uint32_t s = 0; s < numSlots; s++)
+    {
+      uint32_t best = 0;
+      for (uint32_t n = 0; n < numNodes; n++)
+        {
+          current[n] += counts[n];
+          if (current[n] > current[best])
+            {
+              best = n;
+            }
+        }
+      current[best] -= numSlots;
+      owners[s] = best;
+    }
+  return owners;
+}
+
+TypeId
+TdmaPathScheduleGenerator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaPathScheduleGenerator")
+    .SetParent<TdmaScheduleGenerator> ()
+    .AddConstructor<TdmaPathScheduleGenerator> ();
+  return tid;
+}
+
+void
+TdmaPathScheduleGenerator::AddPath (const std::vector<uint32_t> &path)
+{
+  NS_LOG_FUNCTION (this << path.size ());
+  m_paths.push_back (path);
+}
+
+std::vector<uint32_t>
+TdmaPathScheduleGenerator::GetNodeOrder (uint32_t numNodes) const
+{
+  NS_LOG_FUNCTION (this << numNodes);
+  // Kahn's algorithm over the hop precedences of every path
+  std::vector<std::vector<uint32_t> > next (numNodes);
+  std::vector<uint32_t> inDegree (numNodes, 0);
+  for (std::vector<std::vector<uint32_t> >::const_iterator p = m_paths.begin (); p != m_paths.end (); ++p)
+    {
+      for (uint32_t i = 0; i + 1 < p->size (); i++)
+        {
+          uint32_t from = (*p)[i];
+          uint32_t to = (*p)[i + 1];
+          NS_ASSERT_MSG (from < numNodes && to < numNodes, "Path node beyond the " << numNodes << " nodes");
+          next[from].push_back (to);
+          inDegree[to]++;
+        }
+    }
+  std::vector<uint32_t> order;
+  std::vector<bool> placed (numNodes, false);
+  std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t> > ready;
+  uint32_t fallback = 0;
+  while (order.size () < numNodes)
+    {
+      if (ready.empty ())
+        {
+          // start with the nodes no hop waits for, then break cycles by node id
+          for (uint32_t n = 0; n < numNodes; n++)
+            {
+              if (!placed[n] && inDegree[n] == 0)
+                {
+                  ready.push (n);
+                  placed[n] = true;
+                }
+            }
+          if (ready.empty ())
+            {
+              while (placed[fallback])
+                {
+                  fallback++;
+                }
+              NS_LOG_DEBUG ("Breaking a cycle of paths at node " << fallback);
+              ready.push (fallback);
+              placed[fallback] = true;
+            }
+        }
+      uint32_t n = ready.top ();
+      ready.pop ();
+      order.push_back (n);
+      for (std::vector<uint32_t>::const_iterator i = next[n].begin (); i != next[n].end (); ++i)
+        {
+          if (inDegree[*i] > 0 && --inDegree[*i] == 0 && !placed[*i])
+            {
+              ready.push (*i);
+              placed[*i] = true;
+            }
+        }
+    }
+  return order;
+}
+
+std::vector<uint32_t>
+TdmaPathScheduleGenerator::Generate (uint32_t numNodes, uint32_t numSlots) const
+{
+  NS_LOG_FUNCTION (this << numNodes << numSlots);
+  NS_ASSERT (numNodes > 0);
+  std::vector<uint32_t> order = GetNodeOrder (numNodes);
+  std::vector<uint32_t> owners (numSlots, NO_OWNER);
+  uint32_t continuousSlots = numSlots / numNodes;
+  uint32_t remainingSlots = numSlots - continuousSlots * numNodes;
+  uint32_t slot = 0;
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      uint32_t blockSlots = continuousSlots + (i < remainingSlots ? 1 : 0);
+      for (uint32_t j = 0; j < blockSlots; j++)
+        {
+          owners[slot++] = order[i];
+        }
+    }
+  return owners;
+}
+
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_SCHEDULE_GENERATOR_H
+#define TDMA_SCHEDULE_GENERATOR_H
+
+#include "ns3/object.h"
+#include <vector>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \brief computes the slot assignment of a frame
+ *
+ * Generators assign every slot of a single channel frame to one of the
+ * nodes 0 to numNodes-1. They are applied with
+ * TdmaHelper::SetScheduleGenerator.
+ */
+class TdmaScheduleGenerator : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual ~TdmaScheduleGenerator ();
+
+  static const uint32_t NO_OWNER = 0xffffffff;
+
+  /**
+   * \param numNodes number of nodes, with ids 0 to numNodes-1
+   * \param numSlots number of slots per frame
+   * \returns the node id owning each slot, or NO_OWNER for an idle slot
+   */
+  virtual std::vector<uint32_t> Generate (uint32_t numNodes, uint32_t numSlots) const = 0;
+};
+
+/**
+ * \brief interleaved round robin: slot s belongs to node s mod numNodes
+ *
+ * Every node gets its turn once every numNodes slots, which minimises the
+ * worst case channel access delay for equal demands.
+ */
+class TdmaRoundRobinScheduleGenerator : public TdmaScheduleGenerator
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual std::vector<uint32_t> Generate (uint32_t numNodes, uint32_t numSlots) const;
+};
+
+/**
+ * \brief slots shared in proportion to the traffic each node sends
+ *
+ * The slots of a frame are apportioned to the demands with the largest
+ * remainder method, and each node's slots are spread over the frame with a
+ * smooth weighted round robin. Nodes without demand get no slot.
+ */
+class TdmaDemandScheduleGenerator : public TdmaScheduleGenerator
+{
+public:
+  static TypeId GetTypeId (void);
+  /**
+   * \param nodeId node id
+   * \param demand traffic sent by the node, in any unit
+   */
+  void SetDemand (uint32_t nodeId, double demand);
+  /**
+   * \param matrix traffic from node i to node j in matrix[i][j]. Each node's
+   * demand is the traffic it originates.
+   */
+  void SetTrafficMatrix (const std::vector<std::vector<double> > &matrix);
+  virtual std::vector<uint32_t> Generate (uint32_t numNodes, uint32_t numSlots) const;
+private:
+  std::map<uint32_t, double> m_demands;
+};
+
+/**
+ * \brief slots ordered along forwarding paths
+ *
+ * Nodes get contiguous blocks of slots in a topological order of the
+ * forwarding paths added, so that each hop of a path transmits after the
+ * previous one within the same frame and a packet crosses the whole path
+ * in about one frame instead of one frame per hop. Where paths conflict
+ * (a cycle in the hop order), the order of the remaining nodes falls back
+ * to their node ids.
+ */
+class TdmaPathScheduleGenerator : public TdmaScheduleGenerator
+{
+public:
+  static TypeId GetTypeId (void);
+  /**
+   * \param path node ids of the transmitters of a path, from the source to
+   * the last relay
+   */
+  void AddPath (const std::vector<uint32_t> &path);
+  virtual std::vector<uint32_t> Generate (uint32_t numNodes, uint32_t numSlots) const;
+  /**
+   * \param numNodes number of nodes, with ids 0 to numNodes-1
+   * \returns the transmission order of the nodes
+   */
+  std::vector<uint32_t> GetNodeOrder (uint32_t numNodes) const;
+private:
+  std::vector<std::vector<uint32_t> > m_paths;
+};
+
+} // namespace ns3
+
+#endif /* TDMA_SCHEDULE_GENERATOR_H */
@@ -29,9 +29,13 @@
  * US Department of Defense (DoD), and ITTC at The University of Kansas.
  */
 #include "tdma-slot-assignment-parser.h"
-#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "ns3/log.h"
-#include "ns3/uinteger.h"
+#include "ns3/abort.h"
 
 namespace ns3 {
 
@@ -39,6 +43,9 @@ NS_LOG_COMPONENT_DEFINE ("TdmaSlotAssignmentFileParser");
 
 NS_OBJECT_ENSURE_REGISTERED (TdmaSlotAssignmentFileParser);
 
+// longest frame a file may describe, 2^24 slots
+static const uint32_t MAX_SLOTS = 1 << 24;
+
 TypeId TdmaSlotAssignmentFileParser::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::TdmaSlotAssignmentFileParser")
@@ -47,7 +54,11 @@ TypeId TdmaSlotAssignmentFileParser::GetTypeId (void)
 }
 
 TdmaSlotAssignmentFileParser::TdmaSlotAssignmentFileParser (std::string fileName) : m_numRows (0),
-                                                                                    m_numCols (0)
+                                                                                    m_numCols (0),
+                                                                                    m_hoppingChannels (0),
+                                                                                    m_sparse (false),
+                                                                                    m_fixedSlots (false),
+                                                                                    m_lineNumber (0)
 {
   NS_LOG_FUNCTION (fileName);
   m_fileName = fileName;
@@ -62,53 +73,228 @@ void
 TdmaSlotAssignmentFileParser::ParseTdmaSlotInformation ()
 {
   NS_LOG_FUNCTION (this);
-  std::ifstream topgen;
-  topgen.open (m_fileName.c_str ());
-  std::string line;
-  if (!topgen.is_open ())
+  int fd = open (m_fileName.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Couldn't open the file " << m_fileName);
+  struct stat st;
+  NS_ABORT_MSG_IF (fstat (fd, &st) != 0, "Couldn't stat the file " << m_fileName);
+  if (st.st_size > 0)
+    {
+      void *buffer = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      NS_ABORT_MSG_IF (buffer == MAP_FAILED, "Couldn't map the file " << m_fileName);
+      madvise (buffer, st.st_size, MADV_SEQUENTIAL);
+      const char *begin = static_cast<const char *> (buffer);
+      ParseBuffer (begin, begin + st.st_size);
+      munmap (buffer, st.st_size);
+    }
+  close (fd);
+  NS_ABORT_MSG_IF (m_numRows == 0, "No slot assignment in " << m_fileName);
+  NS_LOG_DEBUG ("Nodes in TDMA: " << m_numRows << " slots per frame: " << m_numCols
+                                  << " assignments: " << m_assignments.size ());
+}
+
+void
+TdmaSlotAssignmentFileParser::ParseBuffer (const char *begin, const char *end)
+{
+  const char *p = begin;
+  while (p < end)
+    {
+      m_lineNumber++;
+      const char *eol = static_cast<const char *> (memchr (p, '\n', end - p));
+      if (eol == 0)
+        {
+          eol = end;
+        }
+      const char *comment = static_cast<const char *> (memchr (p, '#', eol - p));
+      ParseLine (p, comment != 0 ? comment : eol);
+      p = eol + 1;
+    }
+}
+
+void
+TdmaSlotAssignmentFileParser::ParseLine (const char *p, const char *end)
+{
+  p = SkipBlanks (p, end);
+  if (p == end)
+    {
+      return;
+    }
+  if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))
+    {
+      ParseDirective (p, end);
+      return;
+    }
+  uint32_t nodeId;
+  p = SkipBlanks (ParseNumber (p, end, nodeId), end);
+  NS_ABORT_MSG_IF (p == end || *p != ':', m_fileName << ":" << m_lineNumber << ": expected ':' after the node id");
+  m_numRows++;
+  if (m_sparse)
+    {
+      ParseSparseSlots (nodeId, p + 1, end);
+    }
+  else
+    {
+      ParseDenseSlots (nodeId, p + 1, end);
+    }
+}
+
+void
+TdmaSlotAssignmentFileParser::ParseDirective (const char *p, const char *end)
+{
+  const char *colon = static_cast<const char *> (memchr (p, ':', end - p));
+  NS_ABORT_MSG_IF (colon == 0, m_fileName << ":" << m_lineNumber << ": expected ':' after the keyword");
+  std::string key (p, colon);
+  key.erase (key.find_last_not_of (" \t\r") + 1);
+  if (key == "format")
+    {
+      const char *value = SkipBlanks (colon + 1, end);
+      const char *valueEnd = end;
+      while (valueEnd > value && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t' || valueEnd[-1] == '\r'))
+        {
+          valueEnd--;
+        }
+      std::string format (value, valueEnd);
+      NS_ABORT_MSG_UNLESS (format == "sparse" || format == "dense",
+                           m_fileName << ":" << m_lineNumber << ": unknown format " << format);
+      m_sparse = (format == "sparse");
+    }
+  else if (key == "slots")
+    {
+      ParseNumber (colon + 1, end, m_numCols);
+      NS_ABORT_MSG_IF (m_numCols > MAX_SLOTS, m_fileName << ":" << m_lineNumber << ": frame longer than "
+                                                         << MAX_SLOTS << " slots");
+      m_fixedSlots = true;
+    }
+  else if (key == "hopping")
+    {
+      uint32_t hoppingChannels;
+      ParseNumber (colon + 1, end, hoppingChannels);
+      NS_ABORT_MSG_IF (hoppingChannels == 0 || hoppingChannels > 0xffff,
+                       m_fileName << ":" << m_lineNumber << ": hopping requires a number of channels");
+      m_hoppingChannels = hoppingChannels;
+    }
+  else
     {
-      NS_LOG_WARN ("Couldn't open the file " << m_fileName);
+      NS_ABORT_MSG (m_fileName << ":" << m_lineNumber << ": unknown keyword " << key);
     }
+}
 
-  while (!topgen.eof ())
+void
+TdmaSlotAssignmentFileParser::ParseDenseSlots (uint32_t nodeId, const char *p, const char *end)
+{
+  uint32_t slot = 0;
+  while (true)
     {
-      SlotArray word;
-      int pos;
-      line.clear ();
-      //getline (topgen, line);
-      topgen >> line;
-      std::string nodeId ("");
-      std::stringstream stream (line);
-      NS_LOG_DEBUG ("line: " << line);
-      getline (stream,nodeId,':');
-      if (nodeId == "")
+      uint32_t value;
+      bool listen;
+      p = SkipBlanks (ParseNumber (ParseListen (p, end, listen), end, value), end);
+      NS_ABORT_MSG_IF (listen && value == 0, m_fileName << ":" << m_lineNumber << ": listen slots need a channel number plus one");
+      if (value != 0)
+        {
+          AddAssignment (nodeId, slot, value - 1, listen);
+        }
+      slot++;
+      if (p == end)
         {
           break;
         }
-      m_numRows++;
-      NS_LOG_DEBUG ("m_numRows:" << m_numRows);
-      line.erase (0,nodeId.size () + 1);
-      word.push_back (atoi (nodeId.c_str ()));
-      NS_LOG_DEBUG ("nodeId: " << nodeId << " line now:" << line);
-      while ( (pos = line.find (',')) > 0)
+      NS_ABORT_MSG_IF (*p != ',', m_fileName << ":" << m_lineNumber << ": slots should only be 0 or a channel number plus one");
+      p++;
+    }
+  if (m_numCols == 0)
+    {
+      m_numCols = slot;
+    }
+  NS_ABORT_MSG_IF (slot != m_numCols, m_fileName << ":" << m_lineNumber << ": expected "
+                                                 << m_numCols << " slots, found " << slot);
+}
+
+void
+TdmaSlotAssignmentFileParser::ParseSparseSlots (uint32_t nodeId, const char *p, const char *end)
+{
+  p = SkipBlanks (p, end);
+  while (p != end)
+    {
+      uint32_t first;
+      uint32_t last;
+      uint32_t channelNumber = 0;
+      bool listen;
+      p = SkipBlanks (ParseNumber (ParseListen (p, end, listen), end, first), end);
+      last = first;
+      if (p != end && *p == '-')
+        {
+          p = SkipBlanks (ParseNumber (p + 1, end, last), end);
+          NS_ABORT_MSG_IF (last < first, m_fileName << ":" << m_lineNumber << ": empty slot range");
+        }
+      // ranges are expanded slot by slot, so bound them before the loop
+      NS_ABORT_MSG_IF (last >= MAX_SLOTS, m_fileName << ":" << m_lineNumber << ": slot " << last
+                                                     << " beyond the longest frame of " << MAX_SLOTS << " slots");
+      if (p != end && *p == '@')
         {
-          NS_LOG_DEBUG ("pos:" << pos);
-          std::string field = line.substr (0,pos);
-          NS_ASSERT_MSG (field == "0" || field == "1", "slots should only be either 0 or 1");
-          line = line.substr (pos + 1);
-          word.push_back (atoi (field.c_str ()));
-          NS_LOG_DEBUG ("field:" << word.back ());
-          m_numCols++;
+          p = SkipBlanks (ParseNumber (p + 1, end, channelNumber), end);
         }
-      NS_ASSERT_MSG (line == "0" || line == "1", "slots should only be either 0 or 1");
-      word.push_back (atoi (line.c_str ()));
-      NS_LOG_DEBUG ("field:" << word.back ());
-      m_slotArray.push_back (word);
-      m_numCols++;
+      for (uint64_t slot = first; slot <= last; slot++)
+        {
+          AddAssignment (nodeId, slot, channelNumber, listen);
+        }
+      if (!m_fixedSlots && last >= m_numCols)
+        {
+          m_numCols = last + 1;
+        }
+      if (p == end)
+        {
+          break;
+        }
+      NS_ABORT_MSG_IF (*p != ',', m_fileName << ":" << m_lineNumber << ": expected ',' between slots");
+      p = SkipBlanks (p + 1, end);
+    }
+}
+
+const char *
+TdmaSlotAssignmentFileParser::ParseNumber (const char *p, const char *end, uint32_t &value) const
+{
+  p = SkipBlanks (p, end);
+  NS_ABORT_MSG_IF (p == end || *p < '0' || *p > '9', m_fileName << ":" << m_lineNumber << ": expected a number");
+  uint64_t v = 0;
+  while (p != end && *p >= '0' && *p <= '9')
+    {
+      v = v * 10 + (*p - '0');
+      NS_ABORT_MSG_IF (v > 0xffffffff, m_fileName << ":" << m_lineNumber << ": number out of range");
+      p++;
+    }
+  value = v;
+  return p;
+}
+
+const char *
+TdmaSlotAssignmentFileParser::ParseListen (const char *p, const char *end, bool &listen) const
+{
+  p = SkipBlanks (p, end);
+  listen = (p != end && *p == 'r');
+  return listen ? p + 1 : p;
+}
+
+const char *
+TdmaSlotAssignmentFileParser::SkipBlanks (const char *p, const char *end)
+{
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    {
+      p++;
     }
-  NS_ASSERT (m_numCols % m_numRows == 0);
-  m_numCols = m_numCols / m_numRows;
-  NS_LOG_DEBUG ("Nodes in TDMA: " << m_numRows << " slots per frame: " << m_numCols);
+  return p;
+}
+
+void
+TdmaSlotAssignmentFileParser::AddAssignment (uint32_t nodeId, uint32_t slot, uint32_t channelNumber, bool listen)
+{
+  NS_ABORT_MSG_IF (channelNumber > 0xffff, m_fileName << ":" << m_lineNumber << ": channel number out of range");
+  NS_ABORT_MSG_IF (m_fixedSlots && slot >= m_numCols, m_fileName << ":" << m_lineNumber << ": slot "
+                                                                 << slot << " beyond the " << m_numCols << " slots of the frame");
+  TdmaSlotAssignment assignment;
+  assignment.nodeId = nodeId;
+  assignment.slot = slot;
+  assignment.channelNumber = channelNumber;
+  assignment.listen = listen;
+  m_assignments.push_back (assignment);
 }
 
 uint32_t
@@ -123,4 +309,16 @@ TdmaSlotAssignmentFileParser::GetTotalSlots (void)
   return m_numCols;
 }
 
+uint16_t
+TdmaSlotAssignmentFileParser::GetHoppingChannels (void) const
+{
+  return m_hoppingChannels;
+}
+
+const TdmaSlotAssignmentFileParser::AssignmentList &
+TdmaSlotAssignmentFileParser::GetAssignments (void) const
+{
+  return m_assignments;
+}
+
 } /* namespace ns3 */
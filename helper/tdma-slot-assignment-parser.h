@@ -32,31 +32,98 @@
 #define __TDMA_PARSER_H__
 
 #include "ns3/object.h"
+#include <vector>
 
 namespace ns3 {
-typedef std::vector<uint32_t> SlotArray;
 class TdmaHelper;
 
+/**
+ * A slot of the frame assigned to a node on a channel number, to transmit
+ * or, for a listen assignment, to receive
+ */
+struct TdmaSlotAssignment
+{
+  uint32_t nodeId;
+  uint32_t slot;
+  uint16_t channelNumber;
+  bool listen; //!< the node listens on the channel in the slot
+};
+
+/**
+ * \brief reads the TDMA slot assignment from a file
+ *
+ * Two formats are supported. The dense format gives a row per node with
+ * a value per slot, 0 for an unassigned slot and k > 0 to assign the slot
+ * on channel number k-1:
+ * \verbatim
+   0:1,1,0,0
+   1:0,0,1,0 \endverbatim
+ * A value prefixed with 'r', such as r2, has the node listen on channel
+ * number k-1 in the slot instead of transmitting.
+ * After a "format:sparse" line, each node line lists the slots assigned to
+ * the node instead, as single slots or inclusive ranges, optionally
+ * followed by '@' and a channel number, and prefixed with 'r' for the
+ * slots the node listens in:
+ * \verbatim
+   format:sparse
+   slots:4
+   0:0-1
+   1:2,3@1,r0-1@1 \endverbatim
+ * Without a "slots:N" line, a sparse frame ends with its last assigned
+ * slot. Frames are limited to 2^24 slots. Text following '#' is ignored, and "hopping:N" enables channel
+ * hopping over N channels. The file is memory mapped and parsed in a
+ * single pass.
+ */
 class TdmaSlotAssignmentFileParser : public Object
 {
 public:
+  typedef std::vector<TdmaSlotAssignment> AssignmentList;
+
   static TypeId GetTypeId (void);
   ~TdmaSlotAssignmentFileParser ();
   TdmaSlotAssignmentFileParser (std::string fileName);
   void ParseTdmaSlotInformation (void);
   uint32_t GetNodeCount (void);
   uint32_t GetTotalSlots (void);
-  std::vector<SlotArray> & GetSlotArrays ()
-  {
-    return m_slotArray;
-  }
+  /**
+   * \returns the number of hopping channels given by a "hopping:N"
+   * line, or 0 if the file does not enable channel hopping
+   */
+  uint16_t GetHoppingChannels (void) const;
+  /**
+   * \returns every slot assignment of the file, in file order
+   */
+  const AssignmentList & GetAssignments (void) const;
 
 private:
+  void ParseBuffer (const char *begin, const char *end);
+  void ParseLine (const char *p, const char *end);
+  void ParseDirective (const char *p, const char *end);
+  void ParseDenseSlots (uint32_t nodeId, const char *p, const char *end);
+  void ParseSparseSlots (uint32_t nodeId, const char *p, const char *end);
+  /**
+   * Parse an unsigned decimal number after optional blanks
+   *
+   * \returns the first character after the number
+   */
+  const char * ParseNumber (const char *p, const char *end, uint32_t &value) const;
+  static const char * SkipBlanks (const char *p, const char *end);
+  void AddAssignment (uint32_t nodeId, uint32_t slot, uint32_t channelNumber, bool listen);
+  /**
+   * Skip an optional 'r' marking a listen assignment
+   *
+   * \returns the first character after it
+   */
+  const char * ParseListen (const char *p, const char *end, bool &listen) const;
+
   std::string m_fileName;
   uint32_t m_numRows; /// Equivalent to number of nodes
   uint32_t m_numCols; /// Equivalent to number of slots
-  std::vector<SlotArray> m_slotArray;
-
+  uint16_t m_hoppingChannels;
+  bool m_sparse;
+  bool m_fixedSlots; //!< m_numCols was given by a "slots:N" line
+  uint32_t m_lineNumber;
+  AssignmentList m_assignments;
 };
 // end namespace ns3
 }
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-static-routing-helper.h"
+#include "tdma-helper.h"
+#include "ns3/tdma-mac-net-device.h"
+#include "ns3/tdma-central-mac.h"
+#include "ns3/simple-wireless-channel.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include <deque>
+
+NS_LOG_COMPONENT_DEFINE ("TdmaStaticRoutingHelper");
+
+namespace ns3 {
+
+static Ptr<TdmaMacLow>
+GetTdmaMacLow (Ptr<NetDevice> device)
+{
+  Ptr<TdmaNetDevice> tdmaDevice = device->GetObject<TdmaNetDevice> ();
+  NS_ABORT_MSG_IF (tdmaDevice == 0, "Device " << device << " not of type ns3::TdmaNetDevice");
+  Ptr<TdmaCentralMac> mac = DynamicCast<TdmaCentralMac> (tdmaDevice->GetMac ());
+  NS_ABORT_MSG_IF (mac == 0, "Device " << device << " has no ns3::TdmaCentralMac");
+  return mac->GetTdmaMacLow ();
+}
+
+static uint32_t
+GetInterface (Ptr<NetDevice> device)
+{
+  Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+  NS_ABORT_MSG_IF (ipv4 == 0, "Node " << device->GetNode ()->GetId () << " has no internet stack");
+  int32_t interface = ipv4->GetInterfaceForDevice (device);
+  NS_ABORT_MSG_IF (interface < 0 || ipv4->GetNAddresses (interface) == 0,
+                   "Device " << device << " has no IPv4 address");
+  return interface;
+}
+
+static Ipv4Address
+GetAddress (Ptr<NetDevice> device)
+{
+  return device->GetNode ()->GetObject<Ipv4> ()->GetAddress (GetInterface (device), 0).GetLocal ();
+}
+
+TdmaStaticRoutingHelper::TdmaStaticRoutingHelper ()
+{
+}
+
+std::vector<std::vector<uint32_t> >
+TdmaStaticRoutingHelper::GetNextHops (NetDeviceContainer devices) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t n = devices.GetN ();
+  std::vector<Ptr<TdmaMacLow> > lows;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      lows.push_back (GetTdmaMacLow (devices.Get (i)));
+    }
+  Ptr<SimpleWirelessChannel> channel = DynamicCast<SimpleWirelessChannel> (devices.Get (0)->GetChannel ());
+  std::vector<std::vector<uint32_t> > neighbours (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < n; j++)
+        {
+          if (channel->IsReachable (lows[i], lows[j]))
+            {
+              neighbours[i].push_back (j);
+            }
+        }
+    }
+
+  std::vector<std::vector<uint32_t> > nextHops (n, std::vector<uint32_t> (n));
+  for (uint32_t source = 0; source < n; source++)
+    {
+      std::vector<uint32_t> &nextHop = nextHops[source];
+      for (uint32_t i = 0; i < n; i++)
+        {
+          nextHop[i] = source;
+        }
+      std::deque<uint32_t> queue;
+      for (std::vector<uint32_t>::const_iterator j = neighbours[source].begin (); j != neighbours[source].end (); ++j)
+        {
+          nextHop[*j] = *j;
+          queue.push_back (*j);
+        }
+      while (!queue.empty ())
+        {
+          uint32_t i = queue.front ();
+          queue.pop_front ();
+          for (std::vector<uint32_t>::const_iterator j = neighbours[i].begin (); j != neighbours[i].end (); ++j)
+            {
+              if (nextHop[*j] == source && *j != source)
+                {
+                  // the first hop towards i leads to j as well
+                  nextHop[*j] = nextHop[i];
+                  queue.push_back (*j);
+                }
+            }
+        }
+    }
+  return nextHops;
+}
+
+void
+TdmaStaticRoutingHelper::PopulateRoutingTables (NetDeviceContainer devices) const
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<std::vector<uint32_t> > nextHops = GetNextHops (devices);
+  Ipv4StaticRoutingHelper staticRoutingHelper;
+  for (uint32_t source = 0; source < devices.GetN (); source++)
+    {
+      Ptr<NetDevice> device = devices.Get (source);
+      Ptr<Ipv4StaticRouting> routing = staticRoutingHelper.GetStaticRouting (device->GetNode ()->GetObject<Ipv4> ());
+      NS_ABORT_MSG_IF (routing == 0, "Node " << device->GetNode ()->GetId () << " has no Ipv4StaticRouting");
+      uint32_t interface = GetInterface (device);
+      for (uint32_t destination = 0; destination < devices.GetN (); destination++)
+        {
+          uint32_t nextHop = nextHops[source][destination];
+          if (nextHop == source)
+            {
+              continue;
+            }
+          NS_LOG_DEBUG ("node " << device->GetNode ()->GetId () << " to " << GetAddress (devices.Get (destination))
+                                << " via " << GetAddress (devices.Get (nextHop)));
+          routing->AddHostRouteTo (GetAddress (devices.Get (destination)), GetAddress (devices.Get (nextHop)), interface);
+        }
+    }
+  TdmaHelper::PopulateArpCaches (devices);
+}
+
+} // namespace ns3
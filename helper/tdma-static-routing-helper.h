@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_STATIC_ROUTING_HELPER_H
+#define TDMA_STATIC_ROUTING_HELPER_H
+
+#include "ns3/net-device-container.h"
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief install shortest path routes derived from the connectivity of a
+ * SimpleWirelessChannel
+ *
+ * The connectivity graph of the devices is read from the channel at the
+ * current node positions, and a breadth first search from every device
+ * gives the routes with the fewest hops. They are installed as host routes
+ * of Ipv4StaticRouting, with the ARP caches filled by
+ * TdmaHelper::PopulateArpCaches, so traffic can start at once instead of
+ * after a routing protocol converges. The routes are not updated if nodes
+ * move afterwards.
+ */
+class TdmaStaticRoutingHelper
+{
+public:
+  TdmaStaticRoutingHelper ();
+
+  /**
+   * \param devices TdmaNetDevices on a single channel, whose nodes have
+   * an internet stack with Ipv4StaticRouting and an address on the device
+   */
+  void PopulateRoutingTables (NetDeviceContainer devices) const;
+  /**
+   * \param devices TdmaNetDevices on a single channel
+   * \returns for every device, the index in \p devices of the next hop
+   * towards every other device, or the index of the device itself if it
+   * is unreachable
+   */
+  std::vector<std::vector<uint32_t> > GetNextHops (NetDeviceContainer devices) const;
+};
+
+} // namespace ns3
+
+#endif /* TDMA_STATIC_ROUTING_HELPER_H */
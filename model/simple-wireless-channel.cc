@@ -25,9 +25,18 @@
 #include "ns3/log.h"
 #include "ns3/double.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/ptr.h"
 #include "ns3/net-device.h"
 #include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/random-variable-stream.h"
+#include <cmath>
+#include <algorithm>
+#include "tdma-profiler.h"
 
 NS_LOG_COMPONENT_DEFINE ("SimpleWirelessChannel");
 
@@ -46,53 +55,270 @@ SimpleWirelessChannel::GetTypeId (void)
                    DoubleValue (250),
                    MakeDoubleAccessor (&SimpleWirelessChannel::m_range),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("CollisionDetection",
+                   "Track active receptions per receiver and drop frames that overlap in time",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SimpleWirelessChannel::m_collisionDetection),
+                   MakeBooleanChecker ())
+    .AddAttribute ("PropagationLossModel",
+                   "Propagation loss model used to compute the received power of frames. "
+                   "If unset, frames are received by every device within MaxRange.",
+                   PointerValue (),
+                   MakePointerAccessor (&SimpleWirelessChannel::SetPropagationLossModel,
+                                        &SimpleWirelessChannel::GetPropagationLossModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("PropagationDelayModel",
+                   "Propagation delay model. If unset, the delay is 3.3 ns per meter.",
+                   PointerValue (),
+                   MakePointerAccessor (&SimpleWirelessChannel::SetPropagationDelayModel,
+                                        &SimpleWirelessChannel::GetPropagationDelayModel),
+                   MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("TxPower",
+                   "Transmission power (dBm), used with a PropagationLossModel",
+                   DoubleValue (16.0206),
+                   MakeDoubleAccessor (&SimpleWirelessChannel::m_txPowerDbm),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("RxSensitivity",
+                   "Frames arriving below this power (dBm) are not heard, used with a PropagationLossModel",
+                   DoubleValue (-96.0),
+                   MakeDoubleAccessor (&SimpleWirelessChannel::m_rxSensitivityDbm),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("NoiseFloor",
+                   "Noise power (dBm) at the receivers, used with a PropagationLossModel",
+                   DoubleValue (-93.97),
+                   MakeDoubleAccessor (&SimpleWirelessChannel::m_noiseFloorDbm),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("CacheLinks",
+                   "Reuse the distance, loss and delay of links between stationary nodes "
+                   "until either node changes course. Disable for stochastic loss models.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&SimpleWirelessChannel::m_cacheLinks),
+                   MakeBooleanChecker ())
+    .AddTraceSource ("RxDrop",
+                     "A frame arriving at a device was lost because it overlapped with another frame "
+                     "or, with a PropagationLossModel, because of its SINR",
+                     MakeTraceSourceAccessor (&SimpleWirelessChannel::m_rxDropTrace),
+                     "ns3::SimpleWirelessChannel::RxDropCallback")
   ;
   return tid;
 }
 
 SimpleWirelessChannel::SimpleWirelessChannel ()
-  : m_range (0)
+  : m_range (0),
+    m_collisionDetection (false),
+    m_nextReceptionId (0),
+    m_txPowerDbm (0),
+    m_rxSensitivityDbm (0),
+    m_noiseFloorDbm (0),
+    m_cacheLinks (true),
+    m_defaultErrorRates (true),
+    m_asn (0),
+    m_numHoppingChannels (0)
 {
+  m_errorRv = CreateObject<UniformRandomVariable> ();
+  // default table, roughly a 1 Mb/s DSSS receiver
+  m_errorRates[0.0] = 1.0;
+  m_errorRates[4.0] = 0.5;
+  m_errorRates[8.0] = 0.01;
+  m_errorRates[10.0] = 0.0;
 }
 
 void
-SimpleWirelessChannel::Send (Ptr<const Packet> p, Ptr<TdmaMacLow> sender)
+SimpleWirelessChannel::Send (Ptr<const Packet> p, Ptr<TdmaMacLow> sender, Time txTime)
 {
-  NS_LOG_FUNCTION (p << sender);
-  for (TdmaMacLowList::const_iterator i = m_tdmaMacLowList.begin (); i != m_tdmaMacLowList.end (); ++i)
+  TDMA_PROFILE ("SimpleWirelessChannel::Send");
+  NS_LOG_FUNCTION (p << sender << txTime);
+  uint16_t channelNumber = sender->GetTxChannelNumber ();
+  if (m_numHoppingChannels == 0)
+    {
+      ChannelMembers::const_iterator members = m_channelMembers.find (channelNumber);
+      if (members == m_channelMembers.end ())
+        {
+          NS_LOG_DEBUG ("No device listens on channel " << channelNumber);
+          return;
+        }
+      SendToMembers (p, sender, txTime, members->second, channelNumber);
+      return;
+    }
+  // devices listen on a channel offset o, tuned to physical channel
+  // (asn + o) mod N in this slot, so every offset congruent to the frame's
+  // physical channel minus the asn hears it
+  if (m_channelMembers.empty ())
+    {
+      return;
+    }
+  uint32_t lastOffset = m_channelMembers.rbegin ()->first;
+  for (uint32_t offset = (channelNumber + m_numHoppingChannels - m_asn % m_numHoppingChannels) % m_numHoppingChannels;
+       offset <= lastOffset; offset += m_numHoppingChannels)
+    {
+      ChannelMembers::const_iterator members = m_channelMembers.find (offset);
+      if (members != m_channelMembers.end ())
+        {
+          SendToMembers (p, sender, txTime, members->second, channelNumber);
+        }
+    }
+}
+
+void
+SimpleWirelessChannel::SendToMembers (Ptr<const Packet> p, Ptr<TdmaMacLow> sender, Time txTime,
+                                      const std::vector<uint32_t> &members, uint16_t channelNumber)
+{
+  for (std::vector<uint32_t>::const_iterator it = members.begin (); it != members.end (); ++it)
     {
-      Ptr<TdmaMacLow> tmp = *i;
+      uint32_t i = *it;
+      Ptr<TdmaMacLow> tmp = m_tdmaMacLowList[i];
       if (tmp->GetDevice () == sender->GetDevice ())
         {
           continue;
         }
-      Ptr<MobilityModel> a = sender->GetDevice ()->GetNode ()->GetObject<MobilityModel> ();
-      Ptr<MobilityModel> b = tmp->GetDevice ()->GetNode ()->GetObject<MobilityModel> ();
-      NS_ASSERT_MSG (a && b, "Error:  nodes must have mobility models");
-      double distance = a->GetDistanceFrom (b);
-      NS_LOG_DEBUG ("Distance: " << distance << " Max Range: " << m_range);
-      if (distance > m_range)
+      LinkInfo link = GetLinkInfo (sender, tmp);
+      NS_LOG_DEBUG ("Distance: " << link.distance << " Max Range: " << m_range);
+      if (!link.reachable)
         {
           continue;
         }
-      // speed of light is 3.3 ns/meter
-      Time propagationTime = NanoSeconds (uint64_t (3.3 * distance));
       NS_LOG_DEBUG ("Node " << sender->GetDevice ()->GetNode ()->GetId () << " sending to node " <<
-                    tmp->GetDevice ()->GetNode ()->GetId () << " at distance " << distance <<
-                    " meters; arriving time (ns): " << propagationTime);
-      Simulator::ScheduleWithContext (tmp->GetDevice ()->GetNode ()->GetId (),(propagationTime),
-                                      &TdmaMacLow::Receive, tmp, p->Copy ());
+                    tmp->GetDevice ()->GetNode ()->GetId () << " at distance " << link.distance <<
+                    " meters; arriving time (ns): " << link.delay);
+      StartReception (i, p, txTime, link.delay, link.rxPowerDbm, channelNumber);
+    }
+}
+
+void
+SimpleWirelessChannel::StartReception (uint32_t index, Ptr<const Packet> p, Time txTime, Time delay,
+                                       double rxPowerDbm, uint16_t channelNumber)
+{
+  Ptr<TdmaMacLow> receiver = m_tdmaMacLowList[index];
+  uint32_t nodeId = receiver->GetDevice ()->GetNode ()->GetId ();
+  if (m_collisionDetection || m_loss != 0)
+    {
+      Time rxStart = Simulator::Now () + delay;
+      double powerW = std::pow (10.0, (rxPowerDbm - 30) / 10.0);
+      uint64_t id = AddReception (index, rxStart, rxStart + txTime, powerW, channelNumber);
+      Simulator::ScheduleWithContext (nodeId, txTime + delay,
+                                      &SimpleWirelessChannel::EndReception, this, index, id, p->Copy ());
+    }
+  else
+    {
+      Simulator::ScheduleWithContext (nodeId, txTime + delay,
+                                      &TdmaMacLow::Receive, receiver, p->Copy ());
+    }
+}
+
+void
+SimpleWirelessChannel::EndReceptionWithoutInterference (uint32_t index, Ptr<Packet> packet, double rxPowerDbm)
+{
+  NS_LOG_FUNCTION (this << index << rxPowerDbm);
+  Ptr<TdmaMacLow> receiver = m_tdmaMacLowList[index];
+  if (m_loss != 0)
+    {
+      double noiseW = std::pow (10.0, (m_noiseFloorDbm - 30) / 10.0);
+      double snrDb = 10 * std::log10 (std::pow (10.0, (rxPowerDbm - 30) / 10.0) / noiseW);
+      double per = GetErrorRate (snrDb);
+      if (m_errorRv->GetValue () < per)
+        {
+          NS_LOG_DEBUG ("SNR " << snrDb << " dB, error rate " << per << ", lost");
+          m_rxDropTrace (packet, receiver->GetDevice ());
+          return;
+        }
+    }
+  receiver->Receive (packet);
+}
+
+Ptr<TdmaMacLow>
+SimpleWirelessChannel::GetTdmaMacLow (uint32_t index) const
+{
+  return m_tdmaMacLowList[index];
+}
+
+uint64_t
+SimpleWirelessChannel::AddReception (uint32_t index, Time start, Time end, double powerW, uint16_t channelNumber)
+{
+  ReceptionList &receptions = m_receptions[index];
+  Reception rx;
+  rx.id = m_nextReceptionId++;
+  rx.start = start;
+  rx.end = end;
+  rx.powerW = powerW;
+  rx.channelNumber = channelNumber;
+  rx.interferenceW = 0;
+  rx.collided = false;
+  for (ReceptionList::iterator j = receptions.begin (); m_collisionDetection && j != receptions.end (); ++j)
+    {
+      if (j->channelNumber == channelNumber && j->start < end && start < j->end)
+        {
+          NS_LOG_DEBUG ("Reception " << rx.id << " overlaps reception " << j->id <<
+                        " at device " << index);
+          // any overlap counts as interference over the whole frame
+          j->interferenceW += powerW;
+          rx.interferenceW += j->powerW;
+          j->collided = true;
+          rx.collided = true;
+        }
+    }
+  receptions.push_back (rx);
+  return rx.id;
+}
+
+void
+SimpleWirelessChannel::EndReception (uint32_t index, uint64_t id, Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << index << id);
+  ReceptionList &receptions = m_receptions[index];
+  ReceptionList::iterator j = receptions.begin ();
+  while (j != receptions.end () && j->id != id)
+    {
+      ++j;
+    }
+  NS_ASSERT (j != receptions.end ());
+  Reception rx = *j;
+  receptions.erase (j);
+  Ptr<TdmaMacLow> receiver = m_tdmaMacLowList[index];
+  bool lost = rx.collided;
+  if (m_loss != 0)
+    {
+      double noiseW = std::pow (10.0, (m_noiseFloorDbm - 30) / 10.0);
+      double sinrDb = 10 * std::log10 (rx.powerW / (noiseW + rx.interferenceW));
+      double per = GetErrorRate (sinrDb);
+      lost = m_errorRv->GetValue () < per;
+      NS_LOG_DEBUG ("SINR " << sinrDb << " dB, error rate " << per << (lost ? ", lost" : ""));
+    }
+  if (lost)
+    {
+      NS_LOG_DEBUG ("Dropping frame at node " << receiver->GetDevice ()->GetNode ()->GetId ());
+      m_rxDropTrace (packet, receiver->GetDevice ());
+      return;
     }
+  receiver->Receive (packet);
 }
 
 void
 SimpleWirelessChannel::Add (Ptr<TdmaMacLow> tdmaMacLow)
 {
   NS_LOG_DEBUG (this << " " << tdmaMacLow);
+  m_channelMembers[tdmaMacLow->GetChannelNumber ()].push_back (m_tdmaMacLowList.size ());
   m_tdmaMacLowList.push_back (tdmaMacLow);
+  m_receptions.push_back (ReceptionList ());
   NS_LOG_DEBUG ("current m_tdmaMacLowList size: " << m_tdmaMacLowList.size ());
 }
 
+void
+SimpleWirelessChannel::Retune (Ptr<TdmaMacLow> tdmaMacLow, uint16_t previous)
+{
+  NS_LOG_FUNCTION (this << tdmaMacLow << previous << tdmaMacLow->GetChannelNumber ());
+  std::vector<uint32_t> &from = m_channelMembers[previous];
+  for (std::vector<uint32_t>::iterator i = from.begin (); i != from.end (); ++i)
+    {
+      if (m_tdmaMacLowList[*i] == tdmaMacLow)
+        {
+          m_channelMembers[tdmaMacLow->GetChannelNumber ()].push_back (*i);
+          from.erase (i);
+          return;
+        }
+    }
+  NS_LOG_WARN ("Device " << tdmaMacLow << " is not on channel " << previous);
+}
+
 uint32_t
 SimpleWirelessChannel::GetNDevices (void) const
 {
@@ -104,10 +330,210 @@ SimpleWirelessChannel::GetDevice (uint32_t i) const
   return m_tdmaMacLowList[i]->GetDevice ();
 }
 
+void
+SimpleWirelessChannel::SetChannelHopping (uint64_t asn, uint16_t numChannels)
+{
+  NS_LOG_FUNCTION (this << asn << numChannels);
+  m_asn = asn;
+  m_numHoppingChannels = numChannels;
+}
+
 double
 SimpleWirelessChannel::GetMaxRange (void) const
 {
   return m_range;
 }
 
+double
+SimpleWirelessChannel::GetLinkQuality (Ptr<TdmaMacLow> sender, Mac48Address to)
+{
+  NS_LOG_FUNCTION (this << sender << to);
+  Ptr<TdmaMacLow> receiver = FindTdmaMacLow (to);
+  if (receiver == 0)
+    {
+      NS_LOG_DEBUG ("No device with address " << to << " on this channel");
+      return 0;
+    }
+  return GetLinkInfo (sender, receiver).quality;
+}
+
+bool
+SimpleWirelessChannel::IsReachable (Ptr<TdmaMacLow> sender, Ptr<TdmaMacLow> receiver)
+{
+  return sender != receiver && GetLinkInfo (sender, receiver).reachable;
+}
+
+SimpleWirelessChannel::LinkInfo
+SimpleWirelessChannel::GetLinkInfo (Ptr<TdmaMacLow> sender, Ptr<TdmaMacLow> receiver)
+{
+  Ptr<Node> a = sender->GetDevice ()->GetNode ();
+  Ptr<Node> b = receiver->GetDevice ()->GetNode ();
+  NodeMobility &ma = GetNodeMobility (a);
+  NodeMobility &mb = GetNodeMobility (b);
+  std::pair<uint32_t, uint32_t> key (a->GetId (), b->GetId ());
+  LinkCache::iterator it = m_linkCache.find (key);
+  if (it != m_linkCache.end ()
+      && it->second.senderEpoch == ma.epoch
+      && it->second.receiverEpoch == mb.epoch)
+    {
+      return it->second;
+    }
+  LinkInfo info;
+  info.distance = ma.model->GetDistanceFrom (mb.model);
+  if (m_loss != 0)
+    {
+      info.rxPowerDbm = m_loss->CalcRxPower (m_txPowerDbm, ma.model, mb.model);
+      info.reachable = info.rxPowerDbm >= m_rxSensitivityDbm;
+      double margin = (info.rxPowerDbm - m_rxSensitivityDbm) / (m_txPowerDbm - m_rxSensitivityDbm);
+      info.quality = std::min (1.0, std::max (0.0, margin));
+    }
+  else
+    {
+      info.rxPowerDbm = m_txPowerDbm;
+      info.reachable = info.distance <= m_range;
+      info.quality = (info.distance < m_range) ? 1.0 - info.distance / m_range : 0.0;
+    }
+  if (m_delay != 0)
+    {
+      info.delay = m_delay->GetDelay (ma.model, mb.model);
+    }
+  else
+    {
+      // speed of light is 3.3 ns/meter
+      info.delay = NanoSeconds (uint64_t (3.3 * info.distance));
+    }
+  info.senderEpoch = ma.epoch;
+  info.receiverEpoch = mb.epoch;
+  // moving nodes do not fire course changes while travelling, so only
+  // links between stationary nodes can be trusted across calls
+  Vector va = ma.model->GetVelocity ();
+  Vector vb = mb.model->GetVelocity ();
+  if (m_cacheLinks
+      && va.x == 0 && va.y == 0 && va.z == 0
+      && vb.x == 0 && vb.y == 0 && vb.z == 0)
+    {
+      m_linkCache[key] = info;
+    }
+  return info;
+}
+
+void
+SimpleWirelessChannel::SetPropagationLossModel (Ptr<PropagationLossModel> loss)
+{
+  NS_LOG_FUNCTION (this << loss);
+  m_loss = loss;
+  m_linkCache.clear ();
+}
+
+void
+SimpleWirelessChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+  m_delay = delay;
+  m_linkCache.clear ();
+}
+
+Ptr<PropagationLossModel>
+SimpleWirelessChannel::GetPropagationLossModel (void) const
+{
+  return m_loss;
+}
+
+Ptr<PropagationDelayModel>
+SimpleWirelessChannel::GetPropagationDelayModel (void) const
+{
+  return m_delay;
+}
+
+void
+SimpleWirelessChannel::AddErrorRateEntry (double sinrDb, double per)
+{
+  NS_LOG_FUNCTION (this << sinrDb << per);
+  NS_ASSERT_MSG (per >= 0 && per <= 1, "Error rate must be within [0,1]");
+  if (m_defaultErrorRates)
+    {
+      m_errorRates.clear ();
+      m_defaultErrorRates = false;
+    }
+  m_errorRates[sinrDb] = per;
+}
+
+double
+SimpleWirelessChannel::GetErrorRate (double sinrDb) const
+{
+  if (m_errorRates.empty ())
+    {
+      return 0;
+    }
+  std::map<double, double>::const_iterator hi = m_errorRates.lower_bound (sinrDb);
+  if (hi == m_errorRates.begin ())
+    {
+      return hi->second;
+    }
+  if (hi == m_errorRates.end ())
+    {
+      return m_errorRates.rbegin ()->second;
+    }
+  std::map<double, double>::const_iterator lo = hi;
+  --lo;
+  return lo->second + (hi->second - lo->second) * (sinrDb - lo->first) / (hi->first - lo->first);
+}
+
+int64_t
+SimpleWirelessChannel::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_errorRv->SetStream (stream);
+  return 1;
+}
+
+SimpleWirelessChannel::NodeMobility &
+SimpleWirelessChannel::GetNodeMobility (Ptr<Node> node)
+{
+  NodeMobilityMap::iterator it = m_nodeMobility.find (node->GetId ());
+  if (it != m_nodeMobility.end ())
+    {
+      return it->second;
+    }
+  Ptr<MobilityModel> model = node->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (model, "Error:  nodes must have mobility models");
+  model->TraceConnectWithoutContext ("CourseChange",
+                                     MakeCallback (&SimpleWirelessChannel::CourseChanged, this));
+  NodeMobility mobility;
+  mobility.model = model;
+  mobility.epoch = 0;
+  return m_nodeMobility.insert (std::make_pair (node->GetId (), mobility)).first->second;
+}
+
+void
+SimpleWirelessChannel::CourseChanged (Ptr<const MobilityModel> model)
+{
+  Ptr<Node> node = model->GetObject<Node> ();
+  NS_ASSERT (node != 0);
+  NS_LOG_FUNCTION (this << node->GetId ());
+  NodeMobilityMap::iterator it = m_nodeMobility.find (node->GetId ());
+  if (it != m_nodeMobility.end ())
+    {
+      it->second.epoch++;
+    }
+}
+
+Ptr<TdmaMacLow>
+SimpleWirelessChannel::FindTdmaMacLow (Mac48Address address)
+{
+  AddressMap::const_iterator it = m_addressMap.find (address);
+  if (it != m_addressMap.end ())
+    {
+      return it->second;
+    }
+  // addresses may be assigned after the device joined the channel
+  m_addressMap.clear ();
+  for (TdmaMacLowList::const_iterator i = m_tdmaMacLowList.begin (); i != m_tdmaMacLowList.end (); ++i)
+    {
+      m_addressMap[(*i)->GetAddress ()] = *i;
+    }
+  it = m_addressMap.find (address);
+  return (it != m_addressMap.end ()) ? it->second : 0;
+}
+
 } // namespace ns3
@@ -25,14 +25,21 @@
 #include "ns3/mac48-address.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
+#include "ns3/traced-callback.h"
 #include "tdma-mac-low.h"
 #include "tdma-mac-net-device.h"
 #include <vector>
+#include <list>
+#include <map>
 
 namespace ns3 {
 
 class TdmaMacLow;
 class Packet;
+class MobilityModel;
+class PropagationLossModel;
+class PropagationDelayModel;
+class UniformRandomVariable;
 
 /**
  * \ingroup channel
@@ -45,32 +52,224 @@ public:
   static TypeId GetTypeId (void);
   SimpleWirelessChannel ();
 
+  /**
+   * TracedCallback signature for frames dropped at a receiver.
+   *
+   * \param packet the frame that was lost
+   * \param device the device that failed to receive it
+   */
+  typedef void (* RxDropCallback)(Ptr<const Packet> packet, Ptr<NetDevice> device);
+
   /**
    * Copy the packet to be received at a time equal to the transmission
    * time plus the propagation delay between sender and all receivers
-   * on the channel that are within the range of the sender
+   * on the channel that are within the range of the sender and listen
+   * on the sender's transmit channel number
    *
    * \param p Pointer to packet
    * \param sender sending NetDevice
    * \param txTime transmission time (seconds)
    */
-  void Send (Ptr<const Packet> p, Ptr<TdmaMacLow> sender);
+  void Send (Ptr<const Packet> p, Ptr<TdmaMacLow> sender, Time txTime);
 
   /**
    * Add a device to the channel
    *
    * \param device Device to add
    */
-  void Add (Ptr<TdmaMacLow> tdmaMacLow);
+  virtual void Add (Ptr<TdmaMacLow> tdmaMacLow);
+  /**
+   * Move a device to the receiver set of its new channel number
+   *
+   * \param tdmaMacLow device that changed its channel number
+   * \param previous channel number it listened on until now
+   */
+  void Retune (Ptr<TdmaMacLow> tdmaMacLow, uint16_t previous);
+  /**
+   * Enter channel hopping mode for slot \p asn. A device listening on
+   * channel number o is then tuned to physical channel
+   * (asn + o) mod \p numChannels, and hears the frames sent on it, so
+   * offsets that differ by a multiple of \p numChannels meet in every
+   * slot.
+   *
+   * \param asn absolute slot number of the current slot
+   * \param numChannels number of physical channels hopped over
+   */
+  void SetChannelHopping (uint64_t asn, uint16_t numChannels);
   double GetMaxRange (void) const;
+  /**
+   * Quality of the link from sender to the device owning address \p to,
+   * from 1 (co-located) down to 0 (at or beyond MaxRange). With a
+   * propagation loss model, the quality is the received power margin
+   * above RxSensitivity relative to TxPower. Link state is cached and
+   * only recomputed after a course change of either node.
+   *
+   * \param sender sending TdmaMacLow
+   * \param to destination MAC address
+   * \returns link quality in [0,1]; 0 if the destination is unknown
+   */
+  double GetLinkQuality (Ptr<TdmaMacLow> sender, Mac48Address to);
+  /**
+   * \param sender sending TdmaMacLow
+   * \param receiver receiving TdmaMacLow
+   * \returns true if frames of \p sender are heard by \p receiver, within
+   * MaxRange or above RxSensitivity, at the current positions
+   */
+  bool IsReachable (Ptr<TdmaMacLow> sender, Ptr<TdmaMacLow> receiver);
+  /**
+   * \param loss the propagation loss model used to compute the received
+   * power of every frame. Once set, a frame is heard by every device
+   * where it arrives above RxSensitivity, whatever MaxRange, and is
+   * received with the error rate of its SINR.
+   */
+  void SetPropagationLossModel (Ptr<PropagationLossModel> loss);
+  /**
+   * \param delay the propagation delay model replacing the default
+   * 3.3 ns/m delay
+   */
+  void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
+  /**
+   * \returns the propagation loss model, or 0 if unset
+   */
+  Ptr<PropagationLossModel> GetPropagationLossModel (void) const;
+  /**
+   * \returns the propagation delay model, or 0 if unset
+   */
+  Ptr<PropagationDelayModel> GetPropagationDelayModel (void) const;
+  /**
+   * \param sinrDb signal to interference plus noise ratio (dB)
+   * \param per frame error rate at \p sinrDb
+   *
+   * Add a point to the error rate table. The error rate of a frame is
+   * linearly interpolated between points and saturates at the first
+   * and last point of the table. The first call replaces the default
+   * table.
+   */
+  void AddErrorRateEntry (double sinrDb, double per);
+  /**
+   * \param sinrDb signal to interference plus noise ratio (dB)
+   * \returns the frame error rate at \p sinrDb
+   */
+  double GetErrorRate (double sinrDb) const;
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.
+   *
+   * \param stream first stream index to use
+   * \returns the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
 
   // inherited from ns3::Channel
   virtual uint32_t GetNDevices (void) const;
   virtual Ptr<NetDevice> GetDevice (uint32_t i) const;
 
+protected:
+  /**
+   * Start the reception of a frame at receiver \p index: the frame
+   * arrives after \p delay and lasts \p txTime.
+   *
+   * \param index index of the receiver in the order devices were added
+   * \param p frame sent
+   * \param txTime transmission time of the frame
+   * \param delay propagation delay to the receiver
+   * \param rxPowerDbm power received
+   * \param channelNumber physical channel the frame is sent on
+   */
+  virtual void StartReception (uint32_t index, Ptr<const Packet> p, Time txTime, Time delay,
+                               double rxPowerDbm, uint16_t channelNumber);
+  /**
+   * Deliver a frame whose last bit arrives now at receiver \p index,
+   * unless, with a propagation loss model, it is lost to its SNR. Frames
+   * delivered this way neither suffer nor cause interference.
+   */
+  void EndReceptionWithoutInterference (uint32_t index, Ptr<Packet> packet, double rxPowerDbm);
+  /**
+   * \returns the receiver \p index
+   */
+  Ptr<TdmaMacLow> GetTdmaMacLow (uint32_t index) const;
+
 private:
+  struct LinkInfo
+  {
+    double distance;
+    double quality;
+    double rxPowerDbm;
+    Time delay;
+    bool reachable;
+    uint32_t senderEpoch;
+    uint32_t receiverEpoch;
+  };
+  struct NodeMobility
+  {
+    Ptr<MobilityModel> model;
+    uint32_t epoch;
+  };
+  /**
+   * A frame being received by one device, from the arrival of its
+   * first bit to the arrival of its last bit.
+   */
+  struct Reception
+  {
+    uint64_t id;
+    Time start;
+    Time end;
+    double powerW;
+    double interferenceW;
+    bool collided;
+    uint16_t channelNumber; //!< physical channel of the frame
+  };
+  typedef std::list<Reception> ReceptionList;
+  typedef std::map<std::pair<uint32_t, uint32_t>, LinkInfo> LinkCache;
+  typedef std::map<uint32_t, NodeMobility> NodeMobilityMap;
+  typedef std::map<Mac48Address, Ptr<TdmaMacLow> > AddressMap;
+  typedef std::map<uint16_t, std::vector<uint32_t> > ChannelMembers;
+
+  LinkInfo GetLinkInfo (Ptr<TdmaMacLow> sender, Ptr<TdmaMacLow> receiver);
+  NodeMobility & GetNodeMobility (Ptr<Node> node);
+  void CourseChanged (Ptr<const MobilityModel> model);
+  Ptr<TdmaMacLow> FindTdmaMacLow (Mac48Address address);
+  /**
+   * Start the reception of frame \p p at the reachable devices of
+   * \p members, except the sender
+   */
+  void SendToMembers (Ptr<const Packet> p, Ptr<TdmaMacLow> sender, Time txTime,
+                      const std::vector<uint32_t> &members, uint16_t channelNumber);
+  /**
+   * Register a reception at receiver \p index. With collision detection,
+   * mark it and every reception on the same physical channel it overlaps
+   * with as collided and add their powers to each other's interference.
+   *
+   * \returns the id of the new reception
+   */
+  uint64_t AddReception (uint32_t index, Time start, Time end, double powerW, uint16_t channelNumber);
+  /**
+   * Deliver the frame to receiver \p index unless it collided or, with a
+   * propagation loss model, was lost to its SINR.
+   */
+  void EndReception (uint32_t index, uint64_t id, Ptr<Packet> packet);
+
   TdmaMacLowList m_tdmaMacLowList;
+  ChannelMembers m_channelMembers; //!< indices in m_tdmaMacLowList per channel number
   double m_range;
+  LinkCache m_linkCache;
+  NodeMobilityMap m_nodeMobility;
+  AddressMap m_addressMap;
+  bool m_collisionDetection;
+  std::vector<ReceptionList> m_receptions; //!< active receptions, indexed as m_tdmaMacLowList
+  uint64_t m_nextReceptionId;
+  TracedCallback<Ptr<const Packet>, Ptr<NetDevice> > m_rxDropTrace;
+  Ptr<PropagationLossModel> m_loss;
+  Ptr<PropagationDelayModel> m_delay;
+  double m_txPowerDbm;
+  double m_rxSensitivityDbm;
+  double m_noiseFloorDbm;
+  bool m_cacheLinks;
+  std::map<double, double> m_errorRates; //!< sinr (dB) to frame error rate
+  bool m_defaultErrorRates;
+  Ptr<UniformRandomVariable> m_errorRv;
+  uint64_t m_asn;
+  uint16_t m_numHoppingChannels; //!< 0 when not hopping
 };
 
 } // namespace ns3
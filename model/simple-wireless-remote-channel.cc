@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "simple-wireless-remote-channel.h"
+#include "tdma-controller.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/mpi-receiver.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("SimpleWirelessRemoteChannel");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SimpleWirelessRemoteTag);
+NS_OBJECT_ENSURE_REGISTERED (SimpleWirelessRemoteChannel);
+
+TypeId
+SimpleWirelessRemoteTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SimpleWirelessRemoteTag")
+    .SetParent<Tag> ()
+    .AddConstructor<SimpleWirelessRemoteTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+SimpleWirelessRemoteTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+SimpleWirelessRemoteTag::SimpleWirelessRemoteTag ()
+  : m_rxPowerDbm (0)
+{
+}
+
+void
+SimpleWirelessRemoteTag::SetRxPowerDbm (double rxPowerDbm)
+{
+  m_rxPowerDbm = rxPowerDbm;
+}
+
+double
+SimpleWirelessRemoteTag::GetRxPowerDbm (void) const
+{
+  return m_rxPowerDbm;
+}
+
+uint32_t
+SimpleWirelessRemoteTag::GetSerializedSize (void) const
+{
+  return sizeof (double);
+}
+
+void
+SimpleWirelessRemoteTag::Serialize (TagBuffer i) const
+{
+  i.WriteDouble (m_rxPowerDbm);
+}
+
+void
+SimpleWirelessRemoteTag::Deserialize (TagBuffer i)
+{
+  m_rxPowerDbm = i.ReadDouble ();
+}
+
+void
+SimpleWirelessRemoteTag::Print (std::ostream &os) const
+{
+  os << "RxPower=" << m_rxPowerDbm << "dBm";
+}
+
+TypeId
+SimpleWirelessRemoteChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SimpleWirelessRemoteChannel")
+    .SetParent<SimpleWirelessChannel> ()
+    .AddConstructor<SimpleWirelessRemoteChannel> ()
+    .AddAttribute ("MinFrameSize",
+                   "Size in bytes of the shortest frame sent on the channel, "
+                   "used to compute the lookahead",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&SimpleWirelessRemoteChannel::m_minFrameSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+SimpleWirelessRemoteChannel::SimpleWirelessRemoteChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SimpleWirelessRemoteChannel::Add (Ptr<TdmaMacLow> tdmaMacLow)
+{
+  NS_LOG_FUNCTION (this << tdmaMacLow);
+  uint32_t index = GetNDevices ();
+  SimpleWirelessChannel::Add (tdmaMacLow);
+  Ptr<NetDevice> device = tdmaMacLow->GetDevice ();
+  NS_ASSERT (device != 0);
+  Ptr<MpiReceiver> receiver = device->GetObject<MpiReceiver> ();
+  if (receiver == 0)
+    {
+      receiver = CreateObject<MpiReceiver> ();
+      device->AggregateObject (receiver);
+    }
+  receiver->SetReceiveCallback (MakeBoundCallback (&SimpleWirelessRemoteChannel::ReceiveRemote,
+                                                   Ptr<SimpleWirelessRemoteChannel> (this), index));
+}
+
+void
+SimpleWirelessRemoteChannel::StartReception (uint32_t index, Ptr<const Packet> p, Time txTime, Time delay,
+                                             double rxPowerDbm, uint16_t channelNumber)
+{
+  Ptr<NetDevice> device = GetTdmaMacLow (index)->GetDevice ();
+  Ptr<Node> node = device->GetNode ();
+  if (!MpiInterface::IsEnabled () || node->GetSystemId () == MpiInterface::GetSystemId ())
+    {
+      SimpleWirelessChannel::StartReception (index, p, txTime, delay, rxPowerDbm, channelNumber);
+      return;
+    }
+  NS_LOG_DEBUG ("Sending to node " << node->GetId () << " on rank " << node->GetSystemId ());
+  Ptr<Packet> copy = p->Copy ();
+  SimpleWirelessRemoteTag tag;
+  tag.SetRxPowerDbm (rxPowerDbm);
+  copy->AddPacketTag (tag);
+  MpiInterface::SendPacket (copy, Simulator::Now () + txTime + delay, node->GetId (), device->GetIfIndex ());
+}
+
+void
+SimpleWirelessRemoteChannel::ReceiveRemote (Ptr<SimpleWirelessRemoteChannel> channel, uint32_t index, Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (channel << index << packet);
+  SimpleWirelessRemoteTag tag;
+  bool found = packet->RemovePacketTag (tag);
+  NS_ASSERT_MSG (found, "Frame received from another rank without its received power");
+  channel->EndReceptionWithoutInterference (index, packet, tag.GetRxPowerDbm ());
+}
+
+Time
+SimpleWirelessRemoteChannel::GetLookahead (Ptr<TdmaController> controller) const
+{
+  DataRate rate = controller->GetDataRate ();
+  if (controller->HasLinkDataRates ())
+    {
+      rate = std::max (rate, controller->GetLinkDataRate (1.0));
+    }
+  return controller->CalculateTxTime (Create<Packet> (m_minFrameSize), rate);
+}
+
+} // namespace ns3
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SIMPLE_WIRELESS_REMOTE_CHANNEL_H
+#define SIMPLE_WIRELESS_REMOTE_CHANNEL_H
+
+#include "simple-wireless-channel.h"
+#include "ns3/tag.h"
+
+namespace ns3 {
+
+class TdmaController;
+
+/**
+ * \brief received power of a frame sent to another MPI rank
+ */
+class SimpleWirelessRemoteTag : public Tag
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  SimpleWirelessRemoteTag ();
+
+  void SetRxPowerDbm (double rxPowerDbm);
+  double GetRxPowerDbm (void) const;
+
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+private:
+  double m_rxPowerDbm;
+};
+
+/**
+ * \brief a SimpleWirelessChannel whose devices are partitioned over the
+ * ranks of a distributed simulation
+ *
+ * Every rank creates the whole channel, with every node and device, and
+ * each node runs on the rank of its system id. A frame sent to a device
+ * of another rank is handed to MpiInterface::SendPacket and delivered,
+ * at the time its last bit arrives, through the MpiReceiver this channel
+ * aggregates to every device. Link state is computed on the sending
+ * rank, so positions must be known on every rank.
+ *
+ * Frames crossing ranks are received with the error rate of their SNR:
+ * they neither collide nor interfere with other frames. Frames between
+ * devices of the same rank are received as on a SimpleWirelessChannel.
+ * Without MPI, this channel behaves as a SimpleWirelessChannel.
+ */
+class SimpleWirelessRemoteChannel : public SimpleWirelessChannel
+{
+public:
+  static TypeId GetTypeId (void);
+  SimpleWirelessRemoteChannel ();
+
+  virtual void Add (Ptr<TdmaMacLow> tdmaMacLow);
+  /**
+   * \param controller controller of the devices of this channel
+   * \returns the transmission time of the shortest frame at the highest
+   * rate of \p controller, the earliest a frame can reach another rank
+   * after it is sent. It is a safe lookahead for the distributed simulator.
+   */
+  Time GetLookahead (Ptr<TdmaController> controller) const;
+
+protected:
+  virtual void StartReception (uint32_t index, Ptr<const Packet> p, Time txTime, Time delay,
+                               double rxPowerDbm, uint16_t channelNumber);
+
+private:
+  static void ReceiveRemote (Ptr<SimpleWirelessRemoteChannel> channel, uint32_t index, Ptr<Packet> packet);
+
+  uint32_t m_minFrameSize;
+};
+
+} // namespace ns3
+
+#endif /* SIMPLE_WIRELESS_REMOTE_CHANNEL_H */
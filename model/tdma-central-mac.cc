@@ -33,7 +33,10 @@
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/wifi-mac-header.h"
+#include "ns3/uinteger.h"
 #include "tdma-central-mac.h"
+#include "tdma-profiler.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("TdmaCentralMac");
 
@@ -50,6 +53,11 @@ TdmaCentralMac::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::TdmaCentralMac")
     .SetParent<TdmaMac> ()
     .AddConstructor<TdmaCentralMac> ()
+    .AddAttribute ("ChannelNumber", "The frequency channel this mac listens on.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&TdmaCentralMac::SetChannelNumber,
+                                         &TdmaCentralMac::GetChannelNumber),
+                   MakeUintegerChecker<uint16_t> ())
     .AddTraceSource ("MacTx",
                      "A packet has been received from higher layers and is being processed in preparation for "
                      "queueing for transmission.",
@@ -74,6 +82,16 @@ TdmaCentralMac::GetTypeId (void)
                      "layer.",
                      MakeTraceSourceAccessor (&TdmaCentralMac::m_macRxDropTrace),
 										 "ns3::TdmaCentralMac::MacRxDropCallback")
+    .AddTraceSource ("Sniffer",
+                     "Trace source simulating a non-promiscuous packet sniffer attached to the device: "
+                     "frames sent by the device and frames received for it, with their 802.11 header.",
+                     MakeTraceSourceAccessor (&TdmaCentralMac::m_snifferTrace),
+                     "ns3::Packet::TracedCallback")
+    .AddTraceSource ("PromiscSniffer",
+                     "Trace source simulating a promiscuous packet sniffer attached to the device: "
+                     "every frame sent or received by the device, with its 802.11 header.",
+                     MakeTraceSourceAccessor (&TdmaCentralMac::m_promiscSnifferTrace),
+                     "ns3::Packet::TracedCallback")
   ;
   return tid;
 }
@@ -82,9 +100,12 @@ TdmaCentralMac::TdmaCentralMac ()
 {
   NS_LOG_FUNCTION (this);
   m_isTdmaRunning = false;
+  m_grantBytes = 0;
+  m_grantPackets = 0;
+  m_grantUs = 0;
   m_low = CreateObject<TdmaMacLow> ();
   m_queue = CreateObject<TdmaMacQueue> ();
-  m_queue->SetTdmaMacTxDropCallback (MakeCallback (&TdmaCentralMac::NotifyTxDrop, this));
+  m_queue->SetTdmaMacTxDropCallback (MakeCallback (&TdmaCentralMac::NotifyExpired, this));
 //  LogComponentEnable ("TdmaCentralMac", LOG_LEVEL_DEBUG);
 }
 TdmaCentralMac::~TdmaCentralMac ()
@@ -99,6 +120,7 @@ TdmaCentralMac::DoDispose (void)
   m_device = 0;
   m_queue = 0;
   m_tdmaController = 0;
+  m_stats = 0;
   TdmaMac::DoDispose ();
 }
 
@@ -114,6 +136,16 @@ TdmaCentralMac::NotifyTxDrop (Ptr<const Packet> packet)
   m_macTxDropTrace (packet);
 }
 
+void
+TdmaCentralMac::NotifyExpired (Ptr<const Packet> packet)
+{
+  if (m_stats != 0)
+    {
+      m_stats->NotifyDrop (TdmaMacStats::DROP_EXPIRED);
+    }
+  NotifyTxDrop (packet);
+}
+
 void
 TdmaCentralMac::NotifyRx (Ptr<const Packet> packet)
 {
@@ -149,6 +181,25 @@ TdmaCentralMac::GetChannel (void) const
   return m_channel;
 }
 
+void
+TdmaCentralMac::SetChannelNumber (uint16_t channelNumber)
+{
+  NS_LOG_FUNCTION (this << channelNumber);
+  m_low->SetChannelNumber (channelNumber);
+}
+
+uint16_t
+TdmaCentralMac::GetChannelNumber (void) const
+{
+  return m_low->GetChannelNumber ();
+}
+
+void
+TdmaCentralMac::SetTxChannelNumber (uint16_t channelNumber)
+{
+  m_low->SetTxChannelNumber (channelNumber);
+}
+
 void
 TdmaCentralMac::SetTdmaController (Ptr<TdmaController> controller)
 {
@@ -180,6 +231,18 @@ TdmaCentralMac::GetTdmaMacLow (void) const
   return m_low;
 }
 
+void
+TdmaCentralMac::SetStats (Ptr<TdmaMacStats> stats)
+{
+  m_stats = stats;
+}
+
+Ptr<TdmaMacStats>
+TdmaCentralMac::GetStats (void) const
+{
+  return m_stats;
+}
+
 void
 TdmaCentralMac::SetForwardUpCallback (Callback<void,Ptr<Packet>, Mac48Address, Mac48Address> upCallback)
 {
@@ -289,6 +352,10 @@ TdmaCentralMac::Queue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
   NS_LOG_FUNCTION (this << packet << &hdr);
   if (!m_queue->Enqueue (packet, hdr))
     {
+      if (m_stats != 0)
+        {
+          m_stats->NotifyDrop (TdmaMacStats::DROP_OVERFLOW);
+        }
       NotifyTxDrop (packet);
     }
   //Cannot request for channel access in tdma. Tdma schedules every node in round robin manner
@@ -297,39 +364,92 @@ TdmaCentralMac::Queue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
 
 void
 TdmaCentralMac::StartTransmission (uint64_t transmissionTimeUs)
+{
+  TDMA_PROFILE ("TdmaCentralMac::StartTransmission");
+  NS_LOG_DEBUG (transmissionTimeUs << " usec");
+  m_grantStart = Simulator::Now ();
+  m_grantBytes = 0;
+  m_grantPackets = 0;
+  m_grantUs = transmissionTimeUs;
+  SendPackets (transmissionTimeUs);
+}
+
+void
+TdmaCentralMac::SendPackets (uint64_t transmissionTimeUs)
 {
   NS_LOG_DEBUG (transmissionTimeUs << " usec");
   Time totalTransmissionSlot = MicroSeconds (transmissionTimeUs);
-  if (m_queue->IsEmpty ())
+  while (!m_queue->IsEmpty ())
     {
-      NS_LOG_DEBUG ("queue empty");
-      return;
+      WifiMacHeader header;
+      Ptr<const Packet> peekPacket = m_queue->Peek (&header);
+      Time packetTransmissionTime = m_tdmaController->CalculateTxTime (peekPacket, GetLinkDataRate (header.GetAddr1 ()));
+      NS_LOG_DEBUG ("Packet TransmissionTime(microSeconds): " << packetTransmissionTime.GetMicroSeconds () << "usec");
+      if (packetTransmissionTime < totalTransmissionSlot)
+        {
+          totalTransmissionSlot -= packetTransmissionTime;
+          SendPacketDown (packetTransmissionTime);
+          Simulator::Schedule (packetTransmissionTime, &TdmaCentralMac::SendPackets, this,
+                               totalTransmissionSlot.GetMicroSeconds ());
+          return;
+        }
+      if (packetTransmissionTime < std::max (MicroSeconds (m_grantUs), m_tdmaController->GetLongestGrant (this)))
+        {
+          NS_LOG_DEBUG ("Packet takes more time to transmit than the slot allotted. Will send in next slot");
+          break;
+        }
+      // it would block the queue until it expires
+      NS_LOG_DEBUG ("Packet takes more time to transmit than the longest slot allotted. Dropping it");
+      m_queue->Dequeue (&header);
+      if (m_stats != 0)
+        {
+          m_stats->NotifyDrop (TdmaMacStats::DROP_OVERSIZE);
+        }
+      NotifyTxDrop (peekPacket);
     }
-  WifiMacHeader header;
-  Ptr<const Packet> peekPacket = m_queue->Peek (&header);
-  Time packetTransmissionTime = m_tdmaController->CalculateTxTime (peekPacket);
-  NS_LOG_DEBUG ("Packet TransmissionTime(microSeconds): " << packetTransmissionTime.GetMicroSeconds () << "usec");
-  if (packetTransmissionTime < totalTransmissionSlot)
+  EndTransmission ();
+}
+
+void
+TdmaCentralMac::EndTransmission (void)
+{
+  Time used = Simulator::Now () - m_grantStart;
+  if (m_stats != 0)
     {
-      totalTransmissionSlot -= packetTransmissionTime;
-      Simulator::Schedule (packetTransmissionTime, &TdmaCentralMac::SendPacketDown, this,totalTransmissionSlot);
+      m_stats->NotifyGrantEnd (m_grantPackets, used, MicroSeconds (m_grantUs));
     }
-  else
+  m_tdmaController->NotifyTransmissionEnd (this, m_grantBytes, m_grantPackets,
+                                           used, m_queue->GetSize ());
+}
+
+DataRate
+TdmaCentralMac::GetLinkDataRate (Mac48Address to) const
+{
+  if (!m_tdmaController->HasLinkDataRates () || to.IsGroup ())
     {
-      NS_LOG_DEBUG ("Packet takes more time to transmit than the slot allotted. Will send in next slot");
+      return m_tdmaController->GetDataRate ();
     }
+  double quality = m_channel->GetLinkQuality (m_low, to);
+  NS_LOG_DEBUG ("Link quality to " << to << ": " << quality);
+  return m_tdmaController->GetLinkDataRate (quality);
 }
 
 void
-TdmaCentralMac::SendPacketDown (Time remainingTime)
+TdmaCentralMac::SendPacketDown (Time txTime)
 {
+  TDMA_PROFILE ("TdmaCentralMac::SendPacketDown");
   WifiMacHeader header;
-  Ptr<const Packet> packet = m_queue->Dequeue (&header);
-  m_low->StartTransmission (packet, &header);
+  Time tstamp;
+  Ptr<const Packet> packet = m_queue->Dequeue (&header, &tstamp);
+  m_low->StartTransmission (packet, &header, txTime);
+  if (m_stats != 0)
+    {
+      m_stats->NotifyTx (packet->GetSize (), Simulator::Now () - tstamp);
+    }
+  m_grantBytes += packet->GetSize ();
+  m_grantPackets++;
   TxQueueStart (0);
   NotifyTx (packet);
-  TxQueueStart (0);
-  StartTransmission (remainingTime.GetMicroSeconds ());
 }
 
 void
@@ -395,6 +515,16 @@ TdmaCentralMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
   ForwardUp (packet, hdr->GetAddr3 (), hdr->GetAddr1 ());
 }
 
+void
+TdmaCentralMac::Sniff (Ptr<const Packet> packet, bool own)
+{
+  m_promiscSnifferTrace (packet);
+  if (own)
+    {
+      m_snifferTrace (packet);
+    }
+}
+
 void
 TdmaCentralMac::Initialize ()
 {
@@ -403,6 +533,7 @@ TdmaCentralMac::Initialize ()
   m_queue->SetMacPtr (this);
   m_tdmaController->Start ();
   m_low->SetRxCallback (MakeCallback (&TdmaCentralMac::Receive, this));
+  m_low->SetSnifferCallback (MakeCallback (&TdmaCentralMac::Sniff, this));
   TdmaMac::DoInitialize ();
 }
 
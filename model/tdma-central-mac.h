@@ -36,6 +36,7 @@
 #include "tdma-mac.h"
 #include "tdma-mac-low.h"
 #include "tdma-mac-queue.h"
+#include "tdma-mac-stats.h"
 
 namespace ns3 {
 
@@ -76,6 +77,9 @@ public:
   virtual void SetDevice (Ptr<TdmaNetDevice> device);
   virtual Ptr<TdmaNetDevice> GetDevice (void) const;
   virtual void SetChannel (Ptr<SimpleWirelessChannel> channel);
+  virtual void SetChannelNumber (uint16_t channelNumber);
+  virtual uint16_t GetChannelNumber (void) const;
+  virtual void SetTxChannelNumber (uint16_t channelNumber);
   virtual void StartTransmission (uint64_t transmissionTime);
   virtual void NotifyTx (Ptr<const Packet> packet);
   virtual void NotifyTxDrop (Ptr<const Packet> packet);
@@ -100,10 +104,17 @@ public:
   void SetMaxQueueDelay (Time delay);
   Ptr<SimpleWirelessChannel> GetChannel (void) const;
   Ptr<TdmaMacLow> GetTdmaMacLow (void) const;
+  /**
+   * \param stats statistics to update as packets are sent and dropped,
+   * or 0 to stop collecting them
+   */
+  void SetStats (Ptr<TdmaMacStats> stats);
+  Ptr<TdmaMacStats> GetStats (void) const;
   void RequestForChannelAccess (void);
 
 private:
   void Receive (Ptr<Packet> packet, const WifiMacHeader *hdr);
+  void Sniff (Ptr<const Packet> packet, bool own);
   void ForwardUp (Ptr<Packet> packet, Mac48Address from, Mac48Address to);
   void TxOk (const WifiMacHeader &hdr);
   void TxFailed (const WifiMacHeader &hdr);
@@ -113,7 +124,33 @@ private:
   TdmaCentralMac &operator = (const TdmaCentralMac &o);
   void TxQueueStart (uint32_t index);
   void TxQueueStop (uint32_t index);
-  void SendPacketDown (Time remainingTime);
+  /**
+   * \param txTime time the head-of-line packet occupies the channel
+   *
+   * Dequeue the head-of-line packet and put it on the channel now.
+   */
+  void SendPacketDown (Time txTime);
+  /**
+   * \param transmissionTimeUs time left in the grant
+   *
+   * Send the head-of-line packets that fit in the rest of the grant.
+   */
+  void SendPackets (uint64_t transmissionTimeUs);
+  /**
+   * \param packet packet dropped by the queue after MaxDelay
+   */
+  void NotifyExpired (Ptr<const Packet> packet);
+  /**
+   * Report the use of the grant to the controller
+   */
+  void EndTransmission (void);
+  /**
+   * \param to destination of the frame
+   * \returns the rate to size a transmission to \p to with; the
+   * controller's DataRate unless link rates are configured and \p to is
+   * a unicast address
+   */
+  DataRate GetLinkDataRate (Mac48Address to) const;
 
   /**
    * The trace source fired when packets come into the "top" of the device
@@ -157,6 +194,20 @@ private:
    */
   TracedCallback<Ptr<const Packet> > m_macRxDropTrace;
 
+  /**
+   * The trace source fired for frames sent by the device and frames
+   * received for it, with their 802.11 header and trailer. This is a
+   * non-promiscuous trace.
+   */
+  TracedCallback<Ptr<const Packet> > m_snifferTrace;
+
+  /**
+   * The trace source fired for every frame sent or received by the
+   * device, with its 802.11 header and trailer. This is a promiscuous
+   * trace.
+   */
+  TracedCallback<Ptr<const Packet> > m_promiscSnifferTrace;
+
   Callback<void, Ptr<Packet>,Mac48Address, Mac48Address> m_upCallback;
   Callback<bool,uint32_t> m_queueStart;
   Callback<bool,uint32_t> m_queueStop;
@@ -169,6 +220,11 @@ private:
   Ssid m_ssid;
   Ptr<Node> m_nodePtr;
   bool m_isTdmaRunning;
+  Time m_grantStart;
+  uint32_t m_grantBytes;
+  uint32_t m_grantPackets;
+  uint64_t m_grantUs;
+  Ptr<TdmaMacStats> m_stats;
 };
 
 } // namespace ns3
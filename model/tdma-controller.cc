@@ -30,13 +30,17 @@
  */
 #include "ns3/assert.h"
 #include "ns3/enum.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "tdma-central-mac.h"
 #include "tdma-controller.h"
 #include "tdma-mac.h"
 #include "tdma-mac-low.h"
+#include "tdma-profiler.h"
 #include "ns3/abort.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("TdmaController");
 
@@ -98,7 +102,30 @@ TdmaController::GetTypeId (void)
     .AddAttribute ("TdmaMode","Tdma Mode, Centralized",
                    EnumValue (CENTRALIZED),
                    MakeEnumAccessor (&TdmaController::m_tdmaMode),
-                   MakeEnumChecker (CENTRALIZED, "Centralized"));
+                   MakeEnumChecker (CENTRALIZED, "Centralized"))
+    .AddAttribute ("ChannelHopping",
+                   "Hop the channel of every link over NumChannels physical channels each slot.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TdmaController::SetChannelHopping,
+                                        &TdmaController::GetChannelHopping),
+                   MakeBooleanChecker ())
+    .AddAttribute ("NumChannels", "The number of physical channels hopped over.",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&TdmaController::m_numHoppingChannels),
+                   MakeUintegerChecker<uint16_t> (1))
+    .AddTraceSource ("SlotStart",
+                     "A grant of one or more slots starts, for each channel it is assigned on, "
+                     "or once with a null owner if the slots are idle.",
+                     MakeTraceSourceAccessor (&TdmaController::m_slotStartTrace),
+                     "ns3::TdmaController::SlotStartCallback")
+    .AddTraceSource ("SlotEnd",
+                     "A mac stopped transmitting in its grant.",
+                     MakeTraceSourceAccessor (&TdmaController::m_slotEndTrace),
+                     "ns3::TdmaController::SlotEndCallback")
+    .AddTraceSource ("FrameStart",
+                     "A TDMA frame starts.",
+                     MakeTraceSourceAccessor (&TdmaController::m_frameStartTrace),
+                     "ns3::TdmaController::FrameStartCallback");
   return tid;
 }
 
@@ -110,7 +137,14 @@ TdmaController::TdmaController ()
 		m_totalSlotsAllowed (10000),
 		m_activeEpoch (false),
 		m_tdmaMode (CENTRALIZED),
-    m_channel (0)
+    m_numChannels (1),
+    m_channelHopping (false),
+    m_numHoppingChannels (16),
+    m_asn (0),
+    m_currentSlot (0),
+    m_frame (0),
+    m_channel (0),
+    m_longestSessionsValid (false)
 {
   NS_LOG_FUNCTION (this);
 //  LogComponentEnable ("TdmaController", LOG_LEVEL_DEBUG);
@@ -122,6 +156,10 @@ TdmaController::~TdmaController ()
   m_channel = 0;
   m_bps = 0;
   m_slotPtrs.clear ();
+  m_listenSlots.clear ();
+  m_tunedReceivers.clear ();
+  m_nodeMacs.clear ();
+  m_scheduleFile = 0;
 }
 
 void
@@ -130,6 +168,7 @@ TdmaController::Start (void)
   NS_LOG_FUNCTION (this);
   if (!m_activeEpoch)
     {
+      TDMA_PROFILE_REPORT ();
       m_activeEpoch = true;
       Simulator::Schedule (NanoSeconds (10),&TdmaController::StartTdmaSessions, this);
     }
@@ -139,25 +178,99 @@ void
 TdmaController::StartTdmaSessions (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (m_frame == 0 && m_channelHopping && m_numChannels > m_numHoppingChannels)
+    {
+      NS_LOG_WARN ("Channel offsets beyond the " << m_numHoppingChannels <<
+                   " hopping channels share a physical channel with lower offsets");
+    }
+  m_frameStartTrace (m_frame++);
   ScheduleTdmaSession (0);
 }
 
 void
 TdmaController::AddTdmaSlot (uint32_t slotPos, Ptr<TdmaMac> macPtr)
 {
-  NS_LOG_FUNCTION (slotPos << macPtr);
-  std::pair<std::map<uint32_t, Ptr<TdmaMac> >::iterator, bool> result =
-    m_slotPtrs.insert (std::make_pair (slotPos,macPtr));
-  if (result.second == true)
+  AddTdmaSlot (slotPos, 0, macPtr);
+}
+
+void
+TdmaController::AddTdmaSlot (uint32_t slotPos, uint16_t channelNumber, Ptr<TdmaMac> macPtr)
+{
+  NS_LOG_FUNCTION (slotPos << channelNumber << macPtr);
+  if (slotPos >= m_slotPtrs.size ())
+    {
+      m_slotPtrs.resize (slotPos + 1);
+    }
+  TdmaMacPtrList &owners = m_slotPtrs[slotPos];
+  if (channelNumber >= owners.size ())
+    {
+      owners.resize (channelNumber + 1);
+    }
+  if (owners[channelNumber] == 0)
     {
-      NS_LOG_DEBUG ("Added mac : " << macPtr << " in slot " << slotPos);
+      owners[channelNumber] = macPtr;
+      m_longestSessionsValid = false;
+      m_numChannels = std::max<uint16_t> (m_numChannels, channelNumber + 1);
+      NS_LOG_DEBUG ("Added mac : " << macPtr << " in slot " << slotPos << " channel " << channelNumber);
     }
   else
     {
-      NS_LOG_WARN ("Could not add mac: " << macPtr << " to slot " << slotPos);
+      NS_LOG_WARN ("Could not add mac: " << macPtr << " to slot " << slotPos << " channel " << channelNumber);
+    }
+}
+
+void
+TdmaController::AddListenSlot (uint32_t slotPos, uint16_t channelNumber, Ptr<TdmaMac> macPtr)
+{
+  NS_LOG_FUNCTION (slotPos << channelNumber << macPtr);
+  if (slotPos >= m_listenSlots.size ())
+    {
+      m_listenSlots.resize (slotPos + 1);
+    }
+  TuningList &receivers = m_listenSlots[slotPos];
+  for (TuningList::iterator i = receivers.begin (); i != receivers.end (); ++i)
+    {
+      if (i->first == macPtr)
+        {
+          NS_LOG_WARN ("Mac " << macPtr << " already listens on channel " << i->second << " in slot " << slotPos);
+          i->second = channelNumber;
+          return;
+        }
+    }
+  receivers.push_back (std::make_pair (macPtr, channelNumber));
+  m_numChannels = std::max<uint16_t> (m_numChannels, channelNumber + 1);
+  m_longestSessionsValid = false;
+}
+
+const TdmaController::TuningList &
+TdmaController::GetListenSlots (uint32_t slotNum) const
+{
+  static const TuningList none;
+  return slotNum < m_listenSlots.size () ? m_listenSlots[slotNum] : none;
+}
+
+void
+TdmaController::TuneReceivers (uint32_t slotNum)
+{
+  for (TuningList::const_iterator i = m_tunedReceivers.begin (); i != m_tunedReceivers.end (); ++i)
+    {
+      i->first->SetChannelNumber (i->second);
+    }
+  m_tunedReceivers.clear ();
+  const TuningList &receivers = GetListenSlots (slotNum);
+  for (TuningList::const_iterator i = receivers.begin (); i != receivers.end (); ++i)
+    {
+      m_tunedReceivers.push_back (std::make_pair (i->first, i->first->GetChannelNumber ()));
+      i->first->SetChannelNumber (i->second);
     }
 }
 
+uint16_t
+TdmaController::GetNumChannels (void) const
+{
+  return m_numChannels;
+}
+
 void
 TdmaController::SetSlotTime (Time slotTime)
 {
@@ -238,6 +351,9 @@ TdmaController::SetTotalSlotsAllowed (uint32_t slotsAllowed)
 {
   m_totalSlotsAllowed = slotsAllowed;
   m_slotPtrs.clear ();
+  m_listenSlots.clear ();
+  m_longestSessionsValid = false;
+  m_numChannels = 1;
 }
 
 uint32_t
@@ -249,38 +365,43 @@ TdmaController::GetTotalSlotsAllowed (void) const
 void
 TdmaController::ScheduleTdmaSession (const uint32_t slotNum)
 {
+  TDMA_PROFILE ("TdmaController::ScheduleTdmaSession");
   NS_LOG_FUNCTION (slotNum);
-  std::map<uint32_t, Ptr<TdmaMac> >::iterator it = m_slotPtrs.find (slotNum);
-  if (it == m_slotPtrs.end ())
+  uint32_t numOfSlotsAllotted = GetSessionLength (slotNum);
+  NS_LOG_DEBUG ("Number of slots allotted for this node is: " << numOfSlotsAllotted);
+  Time transmissionSlot = MicroSeconds (GetSlotTime ().GetMicroSeconds () * numOfSlotsAllotted);
+  Time totalTransmissionTimeUs = GetGuardTime () + transmissionSlot;
+  bool idle = true;
+  m_currentSlot = slotNum;
+  TuneReceivers (slotNum);
+  if (m_channelHopping && m_channel != 0)
     {
-      NS_LOG_WARN ("No MAC ptrs in TDMA controller");
+      m_channel->SetChannelHopping (m_asn, m_numHoppingChannels);
     }
-  uint32_t numOfSlotsAllotted = 1;
-  while (1)
+  for (uint16_t channelNumber = 0; channelNumber < m_numChannels; ++channelNumber)
     {
-      std::map<uint32_t, Ptr<TdmaMac> >::iterator j = m_slotPtrs.find (slotNum + numOfSlotsAllotted);
-      if (j != m_slotPtrs.end ())
+      Ptr<TdmaMac> owner = GetSlotOwner (slotNum, channelNumber);
+      if (owner != 0)
         {
-          if (it->second == j->second)
+          uint16_t txChannel = channelNumber;
+          if (m_channelHopping)
             {
-              numOfSlotsAllotted++;
-            }
-          else
-            {
-              break;
+              txChannel = GetHoppingChannel (m_asn, channelNumber, m_numHoppingChannels);
+              MY_DEBUG ("asn " << m_asn << " offset " << channelNumber << " on channel " << txChannel);
             }
-        }
-      else
-        {
-          break;
+          owner->SetTxChannelNumber (txChannel);
+          m_slotStartTrace (slotNum, channelNumber, owner, transmissionSlot);
+          owner->StartTransmission (transmissionSlot.GetMicroSeconds ());
+          idle = false;
         }
     }
-  NS_LOG_DEBUG ("Number of slots allotted for this node is: " << numOfSlotsAllotted);
-  Time transmissionSlot = MicroSeconds (GetSlotTime ().GetMicroSeconds () * numOfSlotsAllotted);
-  Time totalTransmissionTimeUs = GetGuardTime () + transmissionSlot;
-  NS_ASSERT (it->second != NULL);
-  it->second->StartTransmission (transmissionSlot.GetMicroSeconds ());
-  if ((slotNum + numOfSlotsAllotted) == GetTotalSlotsAllowed ())
+  if (idle)
+    {
+      NS_LOG_WARN ("No MAC ptrs in TDMA controller for slot " << slotNum);
+      m_slotStartTrace (slotNum, 0, 0, transmissionSlot);
+    }
+  m_asn += numOfSlotsAllotted;
+  if ((slotNum + numOfSlotsAllotted) >= GetTotalSlotsAllowed ())
     {
       NS_LOG_DEBUG ("Starting over all sessions again");
       Simulator::Schedule ((totalTransmissionTimeUs + GetInterFrameTimeInterval ()), &TdmaController::StartTdmaSessions, this);
@@ -292,6 +413,158 @@ TdmaController::ScheduleTdmaSession (const uint32_t slotNum)
     }
 }
 
+void
+TdmaController::SetChannelHopping (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  m_channelHopping = enable;
+  m_longestSessionsValid = false;
+}
+
+bool
+TdmaController::GetChannelHopping (void) const
+{
+  return m_channelHopping;
+}
+
+uint16_t
+TdmaController::GetHoppingChannel (uint64_t asn, uint16_t channelOffset, uint16_t numChannels)
+{
+  NS_ASSERT (numChannels > 0);
+  return (asn + channelOffset) % numChannels;
+}
+
+uint64_t
+TdmaController::GetAbsoluteSlotNumber (void) const
+{
+  return m_asn;
+}
+
+uint32_t
+TdmaController::GetSessionLength (uint32_t slotNum) const
+{
+  uint32_t numOfSlotsAllotted = 1;
+  while (!m_channelHopping
+         && slotNum + numOfSlotsAllotted < GetTotalSlotsAllowed ()
+         && HasSameOwners (slotNum, slotNum + numOfSlotsAllotted))
+    {
+      numOfSlotsAllotted++;
+    }
+  return numOfSlotsAllotted;
+}
+
+bool
+TdmaController::HasSameOwners (uint32_t a, uint32_t b) const
+{
+  for (uint16_t channelNumber = 0; channelNumber < m_numChannels; ++channelNumber)
+    {
+      if (GetSlotOwner (a, channelNumber) != GetSlotOwner (b, channelNumber))
+        {
+          return false;
+        }
+    }
+  return GetListenSlots (a) == GetListenSlots (b);
+}
+
+Ptr<TdmaMac>
+TdmaController::GetSlotOwner (uint32_t slot, uint16_t channelNumber) const
+{
+  if (m_scheduleFile != 0)
+    {
+      uint32_t nodeId = m_scheduleFile->GetOwner (slot, channelNumber);
+      if (nodeId < m_nodeMacs.size ())
+        {
+          return m_nodeMacs[nodeId];
+        }
+      return 0;
+    }
+  if (slot < m_slotPtrs.size () && channelNumber < m_slotPtrs[slot].size ())
+    {
+      return m_slotPtrs[slot][channelNumber];
+    }
+  return 0;
+}
+
+Time
+TdmaController::GetLongestGrant (Ptr<TdmaMac> mac)
+{
+  if (!m_longestSessionsValid)
+    {
+      UpdateLongestSessions ();
+    }
+  std::map<Ptr<TdmaMac>, uint32_t>::const_iterator it = m_longestSessions.find (mac);
+  if (it == m_longestSessions.end ())
+    {
+      return Seconds (0);
+    }
+  return MicroSeconds (GetSlotTime ().GetMicroSeconds () * it->second);
+}
+
+void
+TdmaController::UpdateLongestSessions (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_longestSessions.clear ();
+  for (uint32_t slotNum = 0; slotNum < GetTotalSlotsAllowed (); )
+    {
+      uint32_t length = GetSessionLength (slotNum);
+      for (uint16_t channelNumber = 0; channelNumber < m_numChannels; ++channelNumber)
+        {
+          Ptr<TdmaMac> owner = GetSlotOwner (slotNum, channelNumber);
+          if (owner != 0)
+            {
+              uint32_t &longest = m_longestSessions[owner];
+              longest = std::max (longest, length);
+            }
+        }
+      slotNum += length;
+    }
+  m_longestSessionsValid = true;
+}
+
+void
+TdmaController::SetScheduleFile (Ptr<TdmaScheduleFile> file)
+{
+  NS_LOG_FUNCTION (this << file);
+  m_scheduleFile = file;
+  m_totalSlotsAllowed = file->GetNumSlots ();
+  m_numChannels = file->GetNumChannels ();
+  m_slotPtrs.clear ();
+  m_longestSessionsValid = false;
+  if (!file->GetSlotTime ().IsZero ())
+    {
+      SetSlotTime (file->GetSlotTime ());
+    }
+  if (!file->GetGuardTime ().IsZero ())
+    {
+      SetGuardTime (file->GetGuardTime ());
+    }
+  if (!file->GetInterFrameTime ().IsZero ())
+    {
+      SetInterFrameTimeInterval (file->GetInterFrameTime ());
+    }
+}
+
+void
+TdmaController::AddTdmaMac (uint32_t nodeId, Ptr<TdmaMac> macPtr)
+{
+  NS_LOG_FUNCTION (this << nodeId << macPtr);
+  if (nodeId >= m_nodeMacs.size ())
+    {
+      m_nodeMacs.resize (nodeId + 1);
+    }
+  m_nodeMacs[nodeId] = macPtr;
+  m_longestSessionsValid = false;
+}
+
+void
+TdmaController::NotifyTransmissionEnd (Ptr<TdmaMac> mac, uint32_t bytes, uint32_t packets,
+                                       Time used, uint32_t deferred)
+{
+  NS_LOG_FUNCTION (this << mac << bytes << packets << used << deferred);
+  m_slotEndTrace (m_currentSlot, mac, bytes, packets, used, deferred);
+}
+
 Time
 TdmaController::CalculateTxTime (Ptr<const Packet> packet)
 {
@@ -300,4 +573,43 @@ TdmaController::CalculateTxTime (Ptr<const Packet> packet)
   return m_bps.CalculateBytesTxTime (packet->GetSize ());
 }
 
+Time
+TdmaController::CalculateTxTime (Ptr<const Packet> packet, DataRate bps)
+{
+  NS_LOG_FUNCTION (*packet << bps);
+  NS_ASSERT_MSG (packet->GetSize () < 1500,"PacketSize must be less than 1500B, it is: " << packet->GetSize ());
+  return bps.CalculateBytesTxTime (packet->GetSize ());
+}
+
+void
+TdmaController::AddLinkDataRate (double minQuality, DataRate bps)
+{
+  NS_LOG_FUNCTION (this << minQuality << bps);
+  NS_ASSERT_MSG (minQuality >= 0 && minQuality <= 1, "Link quality must be within [0,1]");
+  m_linkDataRates.push_back (std::make_pair (minQuality, bps));
+}
+
+DataRate
+TdmaController::GetLinkDataRate (double quality) const
+{
+  bool found = false;
+  DataRate best;
+  for (std::vector<std::pair<double, DataRate> >::const_iterator i = m_linkDataRates.begin ();
+       i != m_linkDataRates.end (); ++i)
+    {
+      if (i->first <= quality && (!found || best < i->second))
+        {
+          best = i->second;
+          found = true;
+        }
+    }
+  return found ? best : m_bps;
+}
+
+bool
+TdmaController::HasLinkDataRates (void) const
+{
+  return !m_linkDataRates.empty ();
+}
+
 } // namespace ns3
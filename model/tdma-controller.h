@@ -37,6 +37,8 @@
 #include "ns3/packet.h"
 #include "ns3/simple-wireless-channel.h"
 #include "ns3/timer.h"
+#include "ns3/traced-callback.h"
+#include "ns3/tdma-schedule-file.h"
 #include <vector>
 #include <map>
 
@@ -56,9 +58,42 @@ class TdmaController : public Object
 public:
   static TypeId GetTypeId (void);
   TdmaController ();
+
+  /**
+   * TracedCallback signature for the start of a grant.
+   *
+   * \param slot first slot of the grant
+   * \param channelNumber channel number of the grant
+   * \param owner mac granted the channel, or 0 for idle slots
+   * \param duration duration of the grant, without guard time
+   */
+  typedef void (* SlotStartCallback)(uint32_t slot, uint16_t channelNumber,
+                                     Ptr<TdmaMac> owner, Time duration);
+  /**
+   * TracedCallback signature for the end of the transmissions of a mac
+   * in its grant.
+   *
+   * \param slot first slot of the grant
+   * \param owner mac granted the channel
+   * \param bytes bytes sent in the grant
+   * \param packets packets sent in the grant
+   * \param used time from the start of the grant to the end of the last packet
+   * \param deferred packets left in the queue for a later grant
+   */
+  typedef void (* SlotEndCallback)(uint32_t slot, Ptr<TdmaMac> owner, uint32_t bytes,
+                                   uint32_t packets, Time used, uint32_t deferred);
+  /**
+   * TracedCallback signature for the start of a frame.
+   *
+   * \param frame number of the frame, from 0
+   */
+  typedef void (* FrameStartCallback)(uint64_t frame);
   ~TdmaController ();
 
-  typedef std::map<uint32_t,Ptr<TdmaMac> > TdmaMacPtrMap;
+  /// owners of a slot, indexed by channel number; null where unassigned
+  typedef std::vector<Ptr<TdmaMac> > TdmaMacPtrList;
+  /// macs with the channel number their receiver is tuned to
+  typedef std::vector<std::pair<Ptr<TdmaMac>, uint16_t> > TuningList;
 
   /**
    * \param slotTime the duration of a slot.
@@ -74,8 +109,81 @@ public:
    */
   void SetDataRate (DataRate bps);
   /**
+   * Assign a slot on channel number 0
    */
   void AddTdmaSlot (uint32_t slot, Ptr<TdmaMac> macPtr);
+  /**
+   * \param slot slot index in the frame
+   * \param channelNumber frequency channel the mac transmits on in this slot
+   * \param macPtr mac that owns the slot
+   */
+  void AddTdmaSlot (uint32_t slot, uint16_t channelNumber, Ptr<TdmaMac> macPtr);
+  /**
+   * \param slot slot index in the frame
+   * \param channelNumber channel number the mac listens on in this slot
+   * \param macPtr mac whose receiver is tuned
+   *
+   * At the start of the slot, the receiver of \p macPtr is tuned to
+   * \p channelNumber, and tuned back to its own channel number (see
+   * TdmaMac::SetChannelNumber) at the start of the next session without
+   * an entry for it.
+   */
+  void AddListenSlot (uint32_t slot, uint16_t channelNumber, Ptr<TdmaMac> macPtr);
+  /**
+   * \returns the number of frequency channels used by the slot assignment
+   */
+  uint16_t GetNumChannels (void) const;
+  /**
+   * \param file binary schedule to use in place of the slots added with
+   * AddTdmaSlot
+   *
+   * The number of slots and channels are taken from the file, as well as
+   * the slot, guard and inter frame times it sets. Slot owners are looked
+   * up in the file, by node id, when each slot starts.
+   */
+  void SetScheduleFile (Ptr<TdmaScheduleFile> file);
+  /**
+   * \param nodeId node id used for \p macPtr in the schedule file
+   * \param macPtr mac of the node
+   */
+  void AddTdmaMac (uint32_t nodeId, Ptr<TdmaMac> macPtr);
+  /**
+   * \param enable true to hop over NumChannels physical channels
+   *
+   * With channel hopping, the channel number of a slot assignment is a
+   * channel offset and the owner transmits on the physical channel
+   * (absolute slot number + offset) mod NumChannels, as in IEEE 802.15.4e
+   * TSCH. Receivers listening on an offset follow the same sequence.
+   * Every slot is then granted on its own.
+   */
+  void SetChannelHopping (bool enable);
+  bool GetChannelHopping (void) const;
+  /**
+   * \param asn absolute slot number
+   * \param channelOffset channel offset of the link
+   * \param numChannels number of physical channels hopped over
+   * \returns the physical channel of the link in slot \p asn
+   */
+  static uint16_t GetHoppingChannel (uint64_t asn, uint16_t channelOffset, uint16_t numChannels);
+  /**
+   * \returns the number of slots elapsed since the first frame
+   */
+  uint64_t GetAbsoluteSlotNumber (void) const;
+  /**
+   * \returns the number of consecutive slots, starting at \p slotNum,
+   * owned by the same macs on every channel. They are granted as a single
+   * transmission followed by one guard time.
+   */
+  uint32_t GetSessionLength (uint32_t slotNum) const;
+  /**
+   * \returns the mac owning \p slot on \p channelNumber, or 0
+   */
+  Ptr<TdmaMac> GetSlotOwner (uint32_t slot, uint16_t channelNumber) const;
+  /**
+   * \returns the duration of the longest grant of \p mac in a frame,
+   * without guard time, or 0 if it owns no slot
+   */
+  Time GetLongestGrant (Ptr<TdmaMac> mac);
   /**
    */
   void SetInterFrameTimeInterval (Time interFrameTime);
@@ -122,7 +230,45 @@ public:
    * duration.
    */
   void NotifyTxStartNow (Time duration);
+  /**
+   * Called by a mac when it stops transmitting in its grant, because its
+   * queue is empty or its next packet does not fit in the rest of the grant
+   *
+   * \param mac the mac granted the channel
+   * \param bytes bytes sent in the grant
+   * \param packets packets sent in the grant
+   * \param used time from the start of the grant to the end of the last packet
+   * \param deferred packets left in the queue
+   */
+  void NotifyTransmissionEnd (Ptr<TdmaMac> mac, uint32_t bytes, uint32_t packets,
+                              Time used, uint32_t deferred);
   Time CalculateTxTime (Ptr<const Packet> packet);
+  /**
+   * \param packet packet to send
+   * \param bps data rate of the link the packet is sent on
+   * \returns time needed to transmit the packet at \p bps
+   */
+  Time CalculateTxTime (Ptr<const Packet> packet, DataRate bps);
+  /**
+   * \param minQuality lowest link quality (see
+   * SimpleWirelessChannel::GetLinkQuality) at which \p bps is sustainable
+   * \param bps data rate
+   *
+   * Add an entry to the link rate table. Once the table is non-empty,
+   * macs size their unicast transmissions with the highest rate the
+   * link to the destination can sustain.
+   */
+  void AddLinkDataRate (double minQuality, DataRate bps);
+  /**
+   * \param quality link quality in [0,1]
+   * \returns the highest rate sustainable at \p quality, or DataRate
+   * if no entry of the link rate table qualifies
+   */
+  DataRate GetLinkDataRate (double quality) const;
+  /**
+   * \returns true if a link rate table has been configured
+   */
+  bool HasLinkDataRates (void) const;
   void StartTdmaSessions (void);
   void SetChannel (Ptr<SimpleWirelessChannel> c);
   virtual void Start (void);
@@ -136,6 +282,17 @@ private:
   bool IsBusy (void) const;
   void UpdateFrameLength (void);
   void ScheduleTdmaSession (const uint32_t slotNum);
+  bool HasSameOwners (uint32_t a, uint32_t b) const;
+  /**
+   * \brief tune back the receivers tuned for the previous session, then
+   * tune those listening in \p slotNum
+   */
+  void TuneReceivers (uint32_t slotNum);
+  const TuningList & GetListenSlots (uint32_t slotNum) const;
+  /**
+   * \brief walk the sessions of a frame to find the longest of every mac
+   */
+  void UpdateLongestSessions (void);
   Ptr<SimpleWirelessChannel> GetChannel (void) const;
 
 //  Time m_lastRxStart;
@@ -153,8 +310,24 @@ private:
   uint32_t m_totalSlotsAllowed;
   bool m_activeEpoch;
   TdmaMode m_tdmaMode;
-  TdmaMacPtrMap m_slotPtrs;
+  std::vector<TdmaMacPtrList> m_slotPtrs; //!< slot owners, indexed by slot
+  std::vector<TuningList> m_listenSlots; //!< receivers tuned away from their channel number, indexed by slot
+  TuningList m_tunedReceivers; //!< receivers tuned for the current session, with the channel number to restore
+  uint16_t m_numChannels;
+  Ptr<TdmaScheduleFile> m_scheduleFile;
+  std::vector<Ptr<TdmaMac> > m_nodeMacs; //!< macs of a schedule file, indexed by node id
+  bool m_channelHopping;
+  uint16_t m_numHoppingChannels;
+  uint64_t m_asn; //!< absolute slot number of the current slot
+  uint32_t m_currentSlot;
+  uint64_t m_frame;
+  TracedCallback<uint32_t, uint16_t, Ptr<TdmaMac>, Time> m_slotStartTrace;
+  TracedCallback<uint32_t, Ptr<TdmaMac>, uint32_t, uint32_t, Time, uint32_t> m_slotEndTrace;
+  TracedCallback<uint64_t> m_frameStartTrace;
   Ptr<SimpleWirelessChannel> m_channel;
+  std::vector<std::pair<double, DataRate> > m_linkDataRates;
+  std::map<Ptr<TdmaMac>, uint32_t> m_longestSessions; //!< slots of the longest session of every mac
+  bool m_longestSessionsValid;
 };
 
 } // namespace ns3
@@ -32,6 +32,7 @@
 #include "ns3/log.h"
 #include "tdma-mac-low.h"
 #include "ns3/wifi-mac-trailer.h"
+#include "tdma-profiler.h"
 
 NS_LOG_COMPONENT_DEFINE ("TdmaMacLow");
 
@@ -42,7 +43,9 @@ NS_LOG_COMPONENT_DEFINE ("TdmaMacLow");
 namespace ns3 {
 
 TdmaMacLow::TdmaMacLow ()
-  : m_currentPacket (0)
+  : m_currentPacket (0),
+    m_channelNumber (0),
+    m_txChannelNumber (0)
 {
 }
 
@@ -88,6 +91,12 @@ TdmaMacLow::SetRxCallback (Callback<void,Ptr<Packet>,const WifiMacHeader *> call
   m_rxCallback = callback;
 }
 
+void
+TdmaMacLow::SetSnifferCallback (TdmaMacLowSnifferCallback callback)
+{
+  m_snifferCallback = callback;
+}
+
 Ptr<SimpleWirelessChannel>
 TdmaMacLow::GetChannel (void) const
 {
@@ -102,6 +111,40 @@ TdmaMacLow::SetChannel (Ptr<SimpleWirelessChannel> channel)
   m_channel->Add (this);
 }
 
+void
+TdmaMacLow::SetChannelNumber (uint16_t channelNumber)
+{
+  NS_LOG_FUNCTION (channelNumber);
+  if (channelNumber == m_channelNumber)
+    {
+      return;
+    }
+  uint16_t previous = m_channelNumber;
+  m_channelNumber = channelNumber;
+  if (m_channel != 0)
+    {
+      m_channel->Retune (this, previous);
+    }
+}
+
+uint16_t
+TdmaMacLow::GetChannelNumber (void) const
+{
+  return m_channelNumber;
+}
+
+void
+TdmaMacLow::SetTxChannelNumber (uint16_t channelNumber)
+{
+  m_txChannelNumber = channelNumber;
+}
+
+uint16_t
+TdmaMacLow::GetTxChannelNumber (void) const
+{
+  return m_txChannelNumber;
+}
+
 Ptr<TdmaNetDevice>
 TdmaMacLow::GetDevice (void) const
 {
@@ -117,9 +160,10 @@ TdmaMacLow::SetDevice (Ptr<TdmaNetDevice> device)
 
 void
 TdmaMacLow::StartTransmission (Ptr<const Packet> packet,
-                               const WifiMacHeader* hdr)
+                               const WifiMacHeader* hdr,
+                               Time txTime)
 {
-  NS_LOG_FUNCTION (this << packet << hdr);
+  NS_LOG_FUNCTION (this << packet << hdr << txTime);
   m_currentPacket = packet->Copy ();
   m_currentHdr = *hdr;
 
@@ -128,15 +172,25 @@ TdmaMacLow::StartTransmission (Ptr<const Packet> packet,
   m_currentPacket->AddHeader (m_currentHdr);
   WifiMacTrailer fcs;
   m_currentPacket->AddTrailer (fcs);
-  ForwardDown (m_currentPacket, &m_currentHdr);
+  if (!m_snifferCallback.IsNull ())
+    {
+      m_snifferCallback (m_currentPacket, true);
+    }
+  ForwardDown (m_currentPacket, &m_currentHdr, txTime);
   m_currentPacket = 0;
 }
 
 void
 TdmaMacLow::Receive (Ptr<Packet> packet)
 {
+  TDMA_PROFILE ("TdmaMacLow::Receive");
   NS_LOG_DEBUG (*packet);
   WifiMacHeader hdr;
+  if (!m_snifferCallback.IsNull ())
+    {
+      packet->PeekHeader (hdr);
+      m_snifferCallback (packet, hdr.GetAddr1 () == m_self || hdr.GetAddr1 ().IsGroup ());
+    }
   packet->RemoveHeader (hdr);
   if (hdr.IsData () || hdr.IsMgt ())
     {
@@ -160,13 +214,14 @@ TdmaMacLow::GetSize (Ptr<const Packet> packet, const WifiMacHeader *hdr) const
 }
 
 void
-TdmaMacLow::ForwardDown (Ptr<const Packet> packet, const WifiMacHeader* hdr)
+TdmaMacLow::ForwardDown (Ptr<const Packet> packet, const WifiMacHeader* hdr, Time txTime)
 {
   NS_LOG_DEBUG ("send " << hdr->GetTypeString () <<
                 ", to=" << hdr->GetAddr1 () <<
-                ", size=" << packet->GetSize ());
+                ", size=" << packet->GetSize () <<
+                ", duration=" << txTime);
   //HERE IT IS SIMPLEWIRELESSCHANNEL SEND CALL
-  m_channel->Send (packet, this);
+  m_channel->Send (packet, this, txTime);
 }
 
 } // namespace ns3
@@ -58,6 +58,8 @@ class TdmaMacLow : public Object
 {
 public:
   typedef Callback<void, Ptr<Packet>, const WifiMacHeader*> TdmaMacLowRxCallback;
+  /// frame as on the air, and whether it was sent by or addressed to this device
+  typedef Callback<void, Ptr<const Packet>, bool> TdmaMacLowSnifferCallback;
 
   TdmaMacLow ();
   virtual ~TdmaMacLow ();
@@ -73,6 +75,18 @@ public:
    * \param channel Pointer to the channel
    */
   void SetChannel (Ptr<SimpleWirelessChannel> channel);
+  /**
+   * \param channelNumber the frequency channel to listen on
+   *
+   * Only frames sent on this channel number are received.
+   */
+  void SetChannelNumber (uint16_t channelNumber);
+  uint16_t GetChannelNumber (void) const;
+  /**
+   * \param channelNumber the frequency channel to send the next frames on
+   */
+  void SetTxChannelNumber (uint16_t channelNumber);
+  uint16_t GetTxChannelNumber (void) const;
   /**
    * \param callback the callback which receives every incoming packet.
    *
@@ -80,15 +94,23 @@ public:
    * an instance of ns3::TdmaCentralMac.
    */
   void SetRxCallback (Callback<void,Ptr<Packet>,const WifiMacHeader *> callback);
+  /**
+   * \param callback the callback which receives every frame sent, with
+   * its 802.11 header and trailer, and every frame received before it is
+   * filtered by destination address.
+   */
+  void SetSnifferCallback (TdmaMacLowSnifferCallback callback);
   /**
    * \param packet packet to send
    * \param hdr 802.11 header for packet to send
+   * \param txTime time the frame occupies the channel
    *
    * Start the transmission of the input packet and notify the listener
    * of transmission events.
    */
   void StartTransmission (Ptr<const Packet> packet,
-                          const WifiMacHeader* hdr);
+                          const WifiMacHeader* hdr,
+                          Time txTime);
 
   /**
    * \param packet packet received
@@ -102,16 +124,19 @@ public:
   void Receive (Ptr<Packet> packet);
 private:
   uint32_t GetSize (Ptr<const Packet> packet, const WifiMacHeader *hdr) const;
-  void ForwardDown (Ptr<const Packet> packet, const WifiMacHeader *hdr);
+  void ForwardDown (Ptr<const Packet> packet, const WifiMacHeader *hdr, Time txTime);
   virtual Ptr<SimpleWirelessChannel> GetChannel (void) const;
   virtual void DoDispose (void);
   TdmaMacLowRxCallback m_rxCallback;
+  TdmaMacLowSnifferCallback m_snifferCallback;
   Ptr<Packet> m_currentPacket;
   Ptr<SimpleWirelessChannel> m_channel;
   Ptr<TdmaNetDevice> m_device;
   WifiMacHeader m_currentHdr;
   Mac48Address m_self;
   Mac48Address m_bssid;
+  uint16_t m_channelNumber;
+  uint16_t m_txChannelNumber;
 };
 
 } // namespace ns3
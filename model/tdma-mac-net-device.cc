@@ -37,6 +37,7 @@
 #include "ns3/node.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/log.h"
+#include "tdma-profiler.h"
 
 NS_LOG_COMPONENT_DEFINE ("TdmaNetDevice");
 
@@ -314,6 +315,7 @@ TdmaNetDevice::SetReceiveCallback (NetDevice::ReceiveCallback cb)
 void
 TdmaNetDevice::ForwardUp (Ptr<Packet> packet, Mac48Address from, Mac48Address to)
 {
+  TDMA_PROFILE ("TdmaNetDevice::ForwardUp");
   NS_LOG_FUNCTION (*packet << from << to);
   LlcSnapHeader llc;
   packet->RemoveHeader (llc);
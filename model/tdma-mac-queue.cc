@@ -165,7 +165,7 @@ TdmaMacQueue::Cleanup (void)
 }
 
 Ptr<const Packet>
-TdmaMacQueue::Dequeue (WifiMacHeader *hdr)
+TdmaMacQueue::Dequeue (WifiMacHeader *hdr, Time *tstamp)
 {
   NS_LOG_FUNCTION_NOARGS ();
   Cleanup ();
@@ -175,6 +175,10 @@ TdmaMacQueue::Dequeue (WifiMacHeader *hdr)
       m_queue.pop_front ();
       m_size--;
       *hdr = i.hdr;
+      if (tstamp != 0)
+        {
+          *tstamp = i.tstamp;
+        }
       NS_LOG_DEBUG ("Dequeued packet of size: " << i.packet->GetSize ());
       return i.packet;
     }
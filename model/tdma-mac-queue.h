@@ -87,8 +87,9 @@ public:
    * \brief Dequeues a packet based on the header passed to it
    *
    * \param hdr header to be dequeued from the TdmaMacQueue
+   * \param tstamp if not null, set to the time the packet was enqueued
    */
-  Ptr<const Packet> Dequeue (WifiMacHeader *hdr);
+  Ptr<const Packet> Dequeue (WifiMacHeader *hdr, Time *tstamp = 0);
   Ptr<const Packet> Peek (WifiMacHeader *hdr);
   /**
    * If exists, removes <i>packet</i> from queue and returns true. Otherwise it
@@ -96,6 +97,11 @@ public:
    * performed in linear time (O(n)).
    */
   bool Remove (Ptr<const Packet> packet);
+  /**
+   * \param callback the callback invoked for packets dropped because they
+   * stayed longer than MaxDelay in the queue. Packets refused by Enqueue
+   * are left to the caller.
+   */
   void SetTdmaMacTxDropCallback (Callback<void,Ptr<const Packet> > callback);
   void Flush (void);
   /**
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-mac-stats.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("TdmaMacStats");
+
+namespace ns3 {
+NS_OBJECT_ENSURE_REGISTERED (TdmaMacStats);
+
+TdmaMacStats::Histogram::Histogram (double width, uint32_t buckets)
+  : m_width (width),
+    m_buckets (buckets, 0),
+    m_count (0),
+    m_sum (0)
+{
+}
+
+void
+TdmaMacStats::Histogram::Add (double value)
+{
+  uint32_t i = (value > 0) ? static_cast<uint32_t> (value / m_width) : 0;
+  if (i >= m_buckets.size ())
+    {
+      i = m_buckets.size () - 1;
+    }
+  m_buckets[i]++;
+  m_count++;
+  m_sum += value;
+}
+
+uint64_t
+TdmaMacStats::Histogram::GetCount (void) const
+{
+  return m_count;
+}
+
+double
+TdmaMacStats::Histogram::GetMean (void) const
+{
+  return m_count > 0 ? m_sum / m_count : 0;
+}
+
+void
+TdmaMacStats::Histogram::Print (std::ostream &os, std::string name) const
+{
+  os << name << " count " << m_count << " mean " << GetMean () << " buckets";
+  for (uint32_t i = 0; i < m_buckets.size (); i++)
+    {
+      os << ' ' << m_buckets[i];
+    }
+  os << '\n';
+}
+
+TypeId
+TdmaMacStats::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaMacStats")
+    .SetParent<Object> ()
+    .AddConstructor<TdmaMacStats> ()
+    .AddAttribute ("SojournBucketWidth", "Width of the buckets of the queue sojourn time histogram.",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&TdmaMacStats::m_sojournBucketWidth),
+                   MakeTimeChecker ())
+    .AddAttribute ("SojournBuckets", "Number of buckets of the queue sojourn time histogram.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&TdmaMacStats::m_sojournBuckets),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+TdmaMacStats::TdmaMacStats ()
+  : m_sojournBucketWidth (MilliSeconds (1)),
+    m_sojournBuckets (100),
+    m_txPackets (0),
+    m_txBytes (0),
+    m_sojourn (1, 100),
+    m_utilisation (0.1, 10),
+    m_packetsPerGrant (1, 32)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < DROP_REASONS; i++)
+    {
+      m_drops[i] = 0;
+    }
+}
+
+void
+TdmaMacStats::NotifyConstructionCompleted (void)
+{
+  m_sojourn = Histogram (m_sojournBucketWidth.GetSeconds () * 1000, m_sojournBuckets);
+  Object::NotifyConstructionCompleted ();
+}
+
+void
+TdmaMacStats::NotifyTx (uint32_t size, Time sojourn)
+{
+  m_txPackets++;
+  m_txBytes += size;
+  m_sojourn.Add (sojourn.GetSeconds () * 1000);
+}
+
+void
+TdmaMacStats::NotifyGrantEnd (uint32_t packets, Time used, Time duration)
+{
+  m_packetsPerGrant.Add (packets);
+  if (duration.IsStrictlyPositive ())
+    {
+      // the last bucket holds fully used grants
+      m_utilisation.Add (std::min (used.GetSeconds () / duration.GetSeconds (), 0.999999));
+    }
+}
+
+void
+TdmaMacStats::NotifyDrop (enum DropReason reason)
+{
+  m_drops[reason]++;
+}
+
+uint64_t
+TdmaMacStats::GetTxPackets (void) const
+{
+  return m_txPackets;
+}
+
+uint64_t
+TdmaMacStats::GetTxBytes (void) const
+{
+  return m_txBytes;
+}
+
+uint64_t
+TdmaMacStats::GetDrops (enum DropReason reason) const
+{
+  return m_drops[reason];
+}
+
+const TdmaMacStats::Histogram &
+TdmaMacStats::GetSojournHistogram (void) const
+{
+  return m_sojourn;
+}
+
+const TdmaMacStats::Histogram &
+TdmaMacStats::GetUtilisationHistogram (void) const
+{
+  return m_utilisation;
+}
+
+const TdmaMacStats::Histogram &
+TdmaMacStats::GetPacketsPerGrantHistogram (void) const
+{
+  return m_packetsPerGrant;
+}
+
+void
+TdmaMacStats::Print (std::ostream &os) const
+{
+  os << "tx packets " << m_txPackets << " bytes " << m_txBytes << '\n'
+     << "drops overflow " << m_drops[DROP_OVERFLOW] << " expired " << m_drops[DROP_EXPIRED]
+     << " oversize " << m_drops[DROP_OVERSIZE] << '\n';
+  m_sojourn.Print (os, "sojourn(ms)");
+  m_utilisation.Print (os, "utilisation");
+  m_packetsPerGrant.Print (os, "packets/grant");
+}
+
+} // namespace ns3
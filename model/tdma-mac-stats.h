@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_MAC_STATS_H
+#define TDMA_MAC_STATS_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include <vector>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \brief counters and fixed bucket histograms of a TdmaCentralMac
+ *
+ * Accumulates, in memory, the queue sojourn time of every packet sent,
+ * the share of every grant spent transmitting, the packets sent per grant
+ * and the packets dropped by reason. Nothing is written until Print is
+ * called, so the statistics are cheap enough to be left enabled.
+ */
+class TdmaMacStats : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  TdmaMacStats ();
+
+  enum DropReason
+  {
+    DROP_OVERFLOW = 0, //!< the queue was full
+    DROP_EXPIRED,      //!< the packet stayed longer than MaxDelay in the queue
+    DROP_OVERSIZE,     //!< the packet does not fit in a grant
+    DROP_REASONS
+  };
+
+  /**
+   * \brief a histogram with fixed width buckets; the last bucket also
+   * counts every larger value
+   */
+  class Histogram
+  {
+public:
+    Histogram (double width, uint32_t buckets);
+    void Add (double value);
+    uint64_t GetCount (void) const;
+    double GetMean (void) const;
+    void Print (std::ostream &os, std::string name) const;
+private:
+    double m_width;
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count;
+    double m_sum;
+  };
+
+  /**
+   * \param size bytes of a packet handed to the channel
+   * \param sojourn time the packet spent in the queue
+   */
+  void NotifyTx (uint32_t size, Time sojourn);
+  /**
+   * \param packets packets sent in a grant
+   * \param used time spent transmitting in the grant
+   * \param duration duration of the grant
+   */
+  void NotifyGrantEnd (uint32_t packets, Time used, Time duration);
+  void NotifyDrop (enum DropReason reason);
+
+  uint64_t GetTxPackets (void) const;
+  uint64_t GetTxBytes (void) const;
+  uint64_t GetDrops (enum DropReason reason) const;
+  const Histogram & GetSojournHistogram (void) const;
+  const Histogram & GetUtilisationHistogram (void) const;
+  const Histogram & GetPacketsPerGrantHistogram (void) const;
+  void Print (std::ostream &os) const;
+
+private:
+  virtual void NotifyConstructionCompleted (void);
+
+  Time m_sojournBucketWidth;
+  uint32_t m_sojournBuckets;
+  uint64_t m_txPackets;
+  uint64_t m_txBytes;
+  uint64_t m_drops[DROP_REASONS];
+  Histogram m_sojourn; //!< ms
+  Histogram m_utilisation; //!< fraction of the grant
+  Histogram m_packetsPerGrant;
+};
+
+} // namespace ns3
+
+#endif /* TDMA_MAC_STATS_H */
@@ -61,12 +61,7 @@ TdmaMac::GetTypeId (void)
                    MakeSsidAccessor (&TdmaMac::GetSsid,
                                      &TdmaMac::SetSsid),
                    MakeSsidChecker ())
-#if 0
-    // Not currently implemented in this device
-    .AddTraceSource ("Sniffer",
-                     "Trace source simulating a non-promiscuous packet sniffer attached to the device",
-                     MakeTraceSourceAccessor (&TdmaMac::m_snifferTrace))
-#endif
+    // the Sniffer and PromiscSniffer trace sources are provided by TdmaCentralMac
   ;
 
   return tid;
@@ -83,6 +83,20 @@ public:
   virtual Ptr<TdmaController> GetTdmaController (void) const = 0;
   virtual void SetChannel (Ptr<SimpleWirelessChannel> channel) = 0;
   virtual void SetDevice (Ptr<TdmaNetDevice> device) = 0;
+  /**
+   * \param channelNumber the frequency channel this mac listens on
+   */
+  virtual void SetChannelNumber (uint16_t channelNumber) = 0;
+  /**
+   * \returns the frequency channel this mac listens on
+   */
+  virtual uint16_t GetChannelNumber (void) const = 0;
+  /**
+   * \param channelNumber the frequency channel of the next transmissions.
+   *
+   * Set by the TdmaController before granting a slot.
+   */
+  virtual void SetTxChannelNumber (uint16_t channelNumber) = 0;
 
   /**
    * \param packet the packet to send.
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-profiler.h"
+#include "ns3/simulator.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace ns3 {
+
+static std::vector<TdmaProfiler::Counter *> &
+GetCounters (void)
+{
+  static std::vector<TdmaProfiler::Counter *> counters;
+  return counters;
+}
+
+static bool g_reportScheduled = false;
+
+static bool
+CompareTotal (const TdmaProfiler::Counter *a, const TdmaProfiler::Counter *b)
+{
+  return a->ns > b->ns;
+}
+
+TdmaProfiler::Counter *
+TdmaProfiler::Register (std::string name)
+{
+  Counter *counter = new Counter;
+  counter->name = name;
+  counter->calls = 0;
+  counter->ns = 0;
+  GetCounters ().push_back (counter);
+  return counter;
+}
+
+void
+TdmaProfiler::ScheduleReport (void)
+{
+  if (!g_reportScheduled)
+    {
+      g_reportScheduled = true;
+      Simulator::ScheduleDestroy (&TdmaProfiler::Report);
+    }
+}
+
+void
+TdmaProfiler::Report (void)
+{
+  Print (std::clog);
+  Reset ();
+  g_reportScheduled = false;
+}
+
+void
+TdmaProfiler::Print (std::ostream &os)
+{
+  std::vector<Counter *> counters = GetCounters ();
+  std::sort (counters.begin (), counters.end (), &CompareTotal);
+  os << std::left << std::setw (40) << "function" << std::right << std::setw (14) << "calls"
+     << std::setw (14) << "total (ms)" << std::setw (12) << "ns/call" << '\n';
+  for (std::vector<Counter *>::const_iterator i = counters.begin (); i != counters.end (); ++i)
+    {
+      os << std::left << std::setw (40) << (*i)->name << std::right << std::setw (14) << (*i)->calls
+         << std::setw (14) << (*i)->ns / 1000000 << std::setw (12)
+         << ((*i)->calls > 0 ? (*i)->ns / (*i)->calls : 0) << '\n';
+    }
+}
+
+void
+TdmaProfiler::Reset (void)
+{
+  std::vector<Counter *> &counters = GetCounters ();
+  for (std::vector<Counter *>::iterator i = counters.begin (); i != counters.end (); ++i)
+    {
+      (*i)->calls = 0;
+      (*i)->ns = 0;
+    }
+}
+
+} // namespace ns3
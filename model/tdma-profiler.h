@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_PROFILER_H
+#define TDMA_PROFILER_H
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <time.h>
+
+/**
+ * \file
+ * Call counters and timers of the hot paths of the TDMA module.
+ *
+ * They are compiled in only when TDMA_PROFILING is defined, which
+ * "./waf configure --enable-tdma-profiling" does; otherwise the macros
+ * expand to nothing. TDMA_PROFILE (name) at the top of a function counts
+ * its calls and the wall clock time spent in it, including its callees, and
+ * TDMA_PROFILE_REPORT () prints the counters to std::clog when the
+ * simulator is destroyed.
+ */
+
+#ifdef TDMA_PROFILING
+
+#define TDMA_PROFILE(name)                                                \
+  static ::ns3::TdmaProfiler::Counter *tdmaProfileCounter =               \
+    ::ns3::TdmaProfiler::Register (name);                                 \
+  ::ns3::TdmaProfiler::Scope tdmaProfileScope (tdmaProfileCounter)
+
+#define TDMA_PROFILE_REPORT() ::ns3::TdmaProfiler::ScheduleReport ()
+
+#else
+
+#define TDMA_PROFILE(name)
+#define TDMA_PROFILE_REPORT()
+
+#endif /* TDMA_PROFILING */
+
+namespace ns3 {
+
+/**
+ * \brief registry of the TDMA_PROFILE counters
+ */
+class TdmaProfiler
+{
+public:
+  struct Counter
+  {
+    std::string name;
+    uint64_t calls;
+    uint64_t ns;
+  };
+
+  /**
+   * \brief add the time spent from its construction to its destruction
+   * to a counter
+   */
+  class Scope
+  {
+public:
+    Scope (Counter *counter)
+      : m_counter (counter)
+    {
+      clock_gettime (CLOCK_MONOTONIC, &m_start);
+    }
+    ~Scope ()
+    {
+      struct timespec end;
+      clock_gettime (CLOCK_MONOTONIC, &end);
+      m_counter->calls++;
+      m_counter->ns += (end.tv_sec - m_start.tv_sec) * 1000000000ULL + end.tv_nsec - m_start.tv_nsec;
+    }
+private:
+    Counter *m_counter;
+    struct timespec m_start;
+  };
+
+  /**
+   * \param name name of the counter
+   * \returns a new counter, printed by Print
+   */
+  static Counter * Register (std::string name);
+  /**
+   * Print and reset the counters when the simulator is destroyed, once
+   * per simulation
+   */
+  static void ScheduleReport (void);
+  /**
+   * \param os stream to print the calls, total and mean time of every
+   * counter to, by decreasing total time
+   */
+  static void Print (std::ostream &os);
+  static void Reset (void);
+private:
+  static void Report (void);
+};
+
+} // namespace ns3
+
+#endif /* TDMA_PROFILER_H */
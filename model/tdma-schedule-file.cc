@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-schedule-file.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE ("TdmaScheduleFile");
+
+namespace ns3 {
+NS_OBJECT_ENSURE_REGISTERED (TdmaScheduleFile);
+
+const uint32_t TdmaScheduleFile::NO_OWNER;
+const uint16_t TdmaScheduleFile::VERSION;
+const uint16_t TdmaScheduleFile::FLAG_PERIODS;
+
+static const char g_scheduleMagic[4] = { 'T', 'D', 'M', 'S' };
+
+TypeId
+TdmaScheduleFile::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaScheduleFile")
+    .SetParent<Object> ();
+  return tid;
+}
+
+TdmaScheduleFile::TdmaScheduleFile (std::string fileName)
+  : m_fileName (fileName),
+    m_buffer (0),
+    m_size (0),
+    m_header (0),
+    m_owners (0)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  int fd = open (fileName.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Couldn't open the file " << fileName);
+  struct stat st;
+  NS_ABORT_MSG_IF (fstat (fd, &st) != 0, "Couldn't stat the file " << fileName);
+  m_size = st.st_size;
+  NS_ABORT_MSG_IF (m_size < sizeof (Header), fileName << " is too short for a schedule header");
+  m_buffer = mmap (0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (m_buffer == MAP_FAILED, "Couldn't map the file " << fileName);
+  m_header = static_cast<const Header *> (m_buffer);
+  m_owners = reinterpret_cast<const uint32_t *> (static_cast<const char *> (m_buffer) + sizeof (Header));
+
+  NS_ABORT_MSG_IF (memcmp (m_header->magic, g_scheduleMagic, sizeof (g_scheduleMagic)) != 0,
+                   fileName << " is not a binary schedule file");
+  NS_ABORT_MSG_IF (m_header->version != VERSION, fileName << ": unsupported schedule version "
+                                                         << m_header->version);
+  NS_ABORT_MSG_IF (m_header->flags & FLAG_PERIODS, fileName << ": per-slot periods are not supported");
+  NS_ABORT_MSG_IF (m_header->numSlots == 0 || m_header->numChannels == 0, fileName << ": empty schedule");
+  NS_ABORT_MSG_IF (m_size < sizeof (Header) + sizeof (uint32_t) * m_header->numSlots * (uint64_t) m_header->numChannels,
+                   fileName << " is too short for " << m_header->numSlots << " slots and "
+                            << m_header->numChannels << " channels");
+  NS_LOG_DEBUG ("Mapped " << m_header->numSlots << " slots on " << m_header->numChannels << " channels");
+}
+
+TdmaScheduleFile::~TdmaScheduleFile ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_buffer != 0)
+    {
+      munmap (m_buffer, m_size);
+    }
+}
+
+bool
+TdmaScheduleFile::IsScheduleFile (std::string fileName)
+{
+  char magic[sizeof (g_scheduleMagic)];
+  std::ifstream file (fileName.c_str (), std::ios::binary);
+  return file.read (magic, sizeof (magic))
+         && memcmp (magic, g_scheduleMagic, sizeof (magic)) == 0;
+}
+
+void
+TdmaScheduleFile::Write (std::string fileName, uint32_t numSlots, uint16_t numChannels,
+                         Time slotTime, Time guardTime, Time interFrameTime,
+                         const std::vector<uint32_t> &owners)
+{
+  NS_LOG_FUNCTION (fileName << numSlots << numChannels);
+  NS_ABORT_MSG_IF (owners.size () != uint64_t (numSlots) * numChannels,
+                   "Expected " << uint64_t (numSlots) * numChannels << " slot owners, got " << owners.size ());
+  Header header;
+  memcpy (header.magic, g_scheduleMagic, sizeof (g_scheduleMagic));
+  header.version = VERSION;
+  header.flags = 0;
+  header.numSlots = numSlots;
+  header.numChannels = numChannels;
+  header.reserved = 0;
+  header.slotTime = slotTime.GetMicroSeconds ();
+  header.guardTime = guardTime.GetMicroSeconds ();
+  header.interFrameTime = interFrameTime.GetMicroSeconds ();
+  std::ofstream file (fileName.c_str (), std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_IF (!file.is_open (), "Couldn't open the file " << fileName);
+  file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  if (!owners.empty ())
+    {
+      file.write (reinterpret_cast<const char *> (&owners[0]), sizeof (uint32_t) * owners.size ());
+    }
+  NS_ABORT_MSG_IF (!file, "Couldn't write the file " << fileName);
+}
+
+uint32_t
+TdmaScheduleFile::GetNumSlots (void) const
+{
+  return m_header->numSlots;
+}
+
+uint16_t
+TdmaScheduleFile::GetNumChannels (void) const
+{
+  return m_header->numChannels;
+}
+
+Time
+TdmaScheduleFile::GetSlotTime (void) const
+{
+  return MicroSeconds (m_header->slotTime);
+}
+
+Time
+TdmaScheduleFile::GetGuardTime (void) const
+{
+  return MicroSeconds (m_header->guardTime);
+}
+
+Time
+TdmaScheduleFile::GetInterFrameTime (void) const
+{
+  return MicroSeconds (m_header->interFrameTime);
+}
+
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_SCHEDULE_FILE_H
+#define TDMA_SCHEDULE_FILE_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief a TDMA schedule stored in a binary file and used in place
+ *
+ * The file starts with a header, in host byte order:
+ * \verbatim
+   offset size field
+        0    4 magic "TDMS"
+        4    2 version (1)
+        6    2 flags
+        8    4 number of slots per frame
+       12    2 number of channels
+       14    2 reserved (0)
+       16    4 slot time (us)
+       20    4 guard time (us)
+       24    4 inter frame time (us) \endverbatim
+ * followed by the node id owning each (slot, channel), as an array of
+ * uint32_t of size slots x channels in slot major order, with NO_OWNER
+ * for unassigned cells. A zero time keeps the controller's attribute.
+ * The file is memory mapped, so opening it does not depend on the size
+ * of the schedule.
+ */
+class TdmaScheduleFile : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  /**
+   * \param fileName binary schedule file to map
+   */
+  TdmaScheduleFile (std::string fileName);
+  ~TdmaScheduleFile ();
+
+  static const uint32_t NO_OWNER = 0xffffffff;
+  static const uint16_t VERSION = 1;
+  /// the file carries per-slot periods (not supported)
+  static const uint16_t FLAG_PERIODS = 0x1;
+
+  /**
+   * \param fileName file to check
+   * \returns true if the file starts with the magic of a binary schedule
+   */
+  static bool IsScheduleFile (std::string fileName);
+  /**
+   * Write a binary schedule file, for example from a schedule optimiser
+   *
+   * \param fileName file to write
+   * \param numSlots number of slots per frame
+   * \param numChannels number of channels
+   * \param slotTime slot time, or zero to keep the controller's
+   * \param guardTime guard time, or zero to keep the controller's
+   * \param interFrameTime inter frame time, or zero to keep the controller's
+   * \param owners node id owning each (slot, channel), slot major
+   */
+  static void Write (std::string fileName, uint32_t numSlots, uint16_t numChannels,
+                     Time slotTime, Time guardTime, Time interFrameTime,
+                     const std::vector<uint32_t> &owners);
+
+  uint32_t GetNumSlots (void) const;
+  uint16_t GetNumChannels (void) const;
+  Time GetSlotTime (void) const;
+  Time GetGuardTime (void) const;
+  Time GetInterFrameTime (void) const;
+  /**
+   * \returns the node id owning \p slot on \p channelNumber, or NO_OWNER
+   */
+  uint32_t GetOwner (uint32_t slot, uint16_t channelNumber) const
+  {
+    return m_owners[uint64_t (slot) * m_header->numChannels + channelNumber];
+  }
+
+private:
+  struct Header
+  {
+    char magic[4];
+    uint16_t version;
+    uint16_t flags;
+    uint32_t numSlots;
+    uint16_t numChannels;
+    uint16_t reserved;
+    uint32_t slotTime;
+    uint32_t guardTime;
+    uint32_t interFrameTime;
+  };
+
+  std::string m_fileName;
+  void *m_buffer;
+  size_t m_size;
+  const Header *m_header;
+  const uint32_t *m_owners;
+};
+
+} // namespace ns3
+
+#endif /* TDMA_SCHEDULE_FILE_H */
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "tdma-slot-scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+
+NS_LOG_COMPONENT_DEFINE ("TdmaSlotScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (TdmaSlotScheduler);
+
+TypeId
+TdmaSlotScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TdmaSlotScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<TdmaSlotScheduler> ()
+    .AddAttribute ("BucketWidth",
+                   "Time covered by a bucket of the calendar, typically the slot time",
+                   TimeValue (MicroSeconds (1100)),
+                   MakeTimeAccessor (&TdmaSlotScheduler::SetBucketWidth,
+                                     &TdmaSlotScheduler::GetBucketWidth),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+TdmaSlotScheduler::TdmaSlotScheduler ()
+  : m_buckets (2),
+    m_width (1),
+    m_size (0),
+    m_lastTs (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TdmaSlotScheduler::~TdmaSlotScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TdmaSlotScheduler::SetBucketWidth (Time width)
+{
+  NS_LOG_FUNCTION (this << width);
+  NS_ABORT_MSG_IF (width.GetTimeStep () <= 0, "TdmaSlotScheduler: the bucket width must be positive");
+  m_width = width.GetTimeStep ();
+  if (m_size > 0)
+    {
+      Resize (m_buckets.size ());
+    }
+}
+
+Time
+TdmaSlotScheduler::GetBucketWidth (void) const
+{
+  return TimeStep (m_width);
+}
+
+uint32_t
+TdmaSlotScheduler::Hash (uint64_t ts) const
+{
+  return (ts / m_width) % m_buckets.size ();
+}
+
+void
+TdmaSlotScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  DoInsert (ev);
+  m_size++;
+  ResizeIfNeeded ();
+}
+
+void
+TdmaSlotScheduler::DoInsert (const Event &ev)
+{
+  Bucket &bucket = m_buckets[Hash (ev.key.m_ts)];
+  // events mostly come in time order, so search from the end
+  Bucket::iterator i = bucket.end ();
+  while (i != bucket.begin ())
+    {
+      Bucket::iterator prev = i;
+      --prev;
+      if (!(ev.key < prev->key))
+        {
+          break;
+        }
+      i = prev;
+    }
+  bucket.insert (i, ev);
+}
+
+bool
+TdmaSlotScheduler::IsEmpty (void) const
+{
+  return m_size == 0;
+}
+
+uint32_t
+TdmaSlotScheduler::FindNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  uint32_t nBuckets = m_buckets.size ();
+  uint32_t i = Hash (m_lastTs);
+  uint64_t top = (m_lastTs / m_width + 1) * m_width;
+  for (uint32_t n = 0; n < nBuckets; n++)
+    {
+      // the front of a bucket is its earliest event, which belongs to
+      // the current day of the bucket if it is before the day ends
+      if (!m_buckets[i].empty () && m_buckets[i].front ().key.m_ts < top)
+        {
+          return i;
+        }
+      i = (i + 1) % nBuckets;
+      top += m_width;
+    }
+  // no event within a year of buckets: search the earliest directly
+  uint32_t next = nBuckets;
+  for (i = 0; i < nBuckets; i++)
+    {
+      if (!m_buckets[i].empty ()
+          && (next == nBuckets || m_buckets[i].front ().key < m_buckets[next].front ().key))
+        {
+          next = i;
+        }
+    }
+  return next;
+}
+
+Scheduler::Event
+TdmaSlotScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_buckets[FindNext ()].front ();
+}
+
+Scheduler::Event
+TdmaSlotScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  Bucket &bucket = m_buckets[FindNext ()];
+  Event ev = bucket.front ();
+  bucket.pop_front ();
+  m_size--;
+  m_lastTs = ev.key.m_ts;
+  ResizeIfNeeded ();
+  return ev;
+}
+
+void
+TdmaSlotScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  Bucket &bucket = m_buckets[Hash (ev.key.m_ts)];
+  for (Bucket::iterator i = bucket.begin (); i != bucket.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (ev.impl == i->impl);
+          bucket.erase (i);
+          m_size--;
+          ResizeIfNeeded ();
+          return;
+        }
+    }
+  NS_ASSERT_MSG (false, "TdmaSlotScheduler: event " << ev.key.m_uid << " not found");
+}
+
+void
+TdmaSlotScheduler::ResizeIfNeeded (void)
+{
+  uint32_t nBuckets = m_buckets.size ();
+  if (m_size > 2 * nBuckets)
+    {
+      Resize (2 * nBuckets);
+    }
+  else if (nBuckets > 2 && m_size < nBuckets / 2)
+    {
+      Resize (nBuckets / 2);
+    }
+}
+
+void
+TdmaSlotScheduler::Resize (uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << nBuckets);
+  std::vector<Bucket> old (nBuckets);
+  old.swap (m_buckets);
+  for (std::vector<Bucket>::const_iterator i = old.begin (); i != old.end (); ++i)
+    {
+      for (Bucket::const_iterator j = i->begin (); j != i->end (); ++j)
+        {
+          DoInsert (*j);
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2026 The simple-wireless-tdma contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TDMA_SLOT_SCHEDULER_H
+#define TDMA_SLOT_SCHEDULER_H
+
+#include "ns3/scheduler.h"
+#include "ns3/nstime.h"
+#include <vector>
+#include <list>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a calendar queue whose day is a TDMA slot
+ *
+ * Events are hashed into buckets BucketWidth wide, and each bucket is
+ * kept sorted. Unlike ns3::CalendarScheduler, the width is not sampled
+ * from the events but set to the slot time, so the events of a slot,
+ * which TDMA schedules at the slot boundaries and the ends of
+ * transmissions and receptions, share one or two buckets, and
+ * resizing the calendar does not have to sample events. Events are
+ * mostly scheduled in time order, so they are inserted from the end
+ * of their bucket. The number of buckets follows the number of events.
+ */
+class TdmaSlotScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TdmaSlotScheduler ();
+  virtual ~TdmaSlotScheduler ();
+
+  /**
+   * \param width width of a bucket, typically the slot time
+   */
+  void SetBucketWidth (Time width);
+  Time GetBucketWidth (void) const;
+
+  // inherited from ns3::Scheduler
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::list<Scheduler::Event> Bucket;
+
+  uint32_t Hash (uint64_t ts) const;
+  /**
+   * \returns the index of the bucket holding the earliest event
+   */
+  uint32_t FindNext (void) const;
+  void DoInsert (const Event &ev);
+  void ResizeIfNeeded (void);
+  void Resize (uint32_t nBuckets);
+
+  std::vector<Bucket> m_buckets;
+  uint64_t m_width; //!< bucket width, in time steps
+  uint32_t m_size;
+  uint64_t m_lastTs; //!< time of the last event removed, no event is earlier
+};
+
+} // namespace ns3
+
+#endif /* TDMA_SLOT_SCHEDULER_H */
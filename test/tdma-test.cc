@@ -45,6 +45,29 @@
 #include "ns3/config.h"
 #include "ns3/node-container.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/data-rate.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/tdma-mac-net-device.h"
+#include "ns3/tdma-slot-scheduler.h"
+#include "ns3/tdma-slot-assignment-parser.h"
+#include "ns3/tdma-mac-stats.h"
+#include "ns3/tdma-schedule-generator.h"
+#include "ns3/tdma-static-routing-helper.h"
+#include "ns3/tdma-binary-trace.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/inet-socket-address.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <map>
+#include <vector>
 
 namespace ns3 {
 class TdmaSlotAllocationTestCase : public TestCase
@@ -215,12 +238,852 @@ TdmaSlotAllocationTestCase::MacTxTrace (Ptr<Packet> packet, const WifiMacHeader
     }
 }
 
+/**
+ * Create \p numNodes nodes 10 m apart on a line, each with a TdmaNetDevice
+ * and a TdmaCentralMac on \p channel, all driven by one controller sending
+ * at 8 Mb/s with a 100 us guard time. The slots are left to the caller.
+ */
+static Ptr<TdmaController>
+CreateTdmaNetwork (uint32_t numNodes, Time slotTime, Time interFrameTime, uint32_t totalSlots,
+                   Ptr<SimpleWirelessChannel> channel,
+                   std::vector<Ptr<TdmaNetDevice> > &devices,
+                   std::vector<Ptr<TdmaCentralMac> > &macs)
+{
+  NodeContainer nodes;
+  nodes.Create (numNodes);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (0.0),
+                                 "MinY", DoubleValue (0.0),
+                                 "DeltaX", DoubleValue (10),
+                                 "DeltaY", DoubleValue (0),
+                                 "GridWidth", UintegerValue (numNodes),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Ptr<TdmaController> tdmaController = CreateObject<TdmaController> ();
+  tdmaController->SetSlotTime (slotTime);
+  tdmaController->SetGuardTime (MicroSeconds (100));
+  tdmaController->SetInterFrameTimeInterval (interFrameTime);
+  tdmaController->SetDataRate (DataRate ("8Mb/s"));
+  tdmaController->SetTotalSlotsAllowed (totalSlots);
+
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      Ptr<TdmaNetDevice> device = CreateObject<TdmaNetDevice> ();
+      device->SetNode (nodes.Get (i));
+      Ptr<TdmaCentralMac> mac = CreateObject<TdmaCentralMac> ();
+      mac->SetAddress (Mac48Address::Allocate ());
+      device->SetMac (mac);
+      device->SetTdmaController (tdmaController);
+      device->SetChannel (channel);
+      nodes.Get (i)->AddDevice (device);
+      devices.push_back (device);
+      macs.push_back (mac);
+    }
+  return tdmaController;
+}
+
+/**
+ * Saturate every node of a schedule and check the throughput each one
+ * receives against the analytical capacity of the schedule.
+ *
+ * The schedule is a string with the owner of each slot, a node number or
+ * '-' for an idle slot; consecutive slots with the same owner form one
+ * grant. A grant of L slots lasts L * SlotTime and is followed by the
+ * GuardTime, and the frame by the InterFrameTime. A packet is sent only if
+ * it ends before the grant does, so a grant of T us carries
+ * floor ((T - 1) / t) packets of t us, t being the airtime of the payload
+ * plus the LLC/SNAP header at DataRate.
+ */
+class TdmaCapacityTestCase : public TestCase
+{
+public:
+  TdmaCapacityTestCase (std::string schedule, uint32_t interFrameUs);
+  virtual void DoRun (void);
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  std::string m_schedule;
+  uint32_t m_interFrameUs;
+  std::map<Mac48Address, uint64_t> m_rxPackets;
+};
+
+TdmaCapacityTestCase::TdmaCapacityTestCase (std::string schedule, uint32_t interFrameUs)
+  : TestCase ("Tdma capacity of schedule " + schedule),
+    m_schedule (schedule),
+    m_interFrameUs (interFrameUs)
+{
+}
+
+bool
+TdmaCapacityTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxPackets[Mac48Address::ConvertFrom (from)]++;
+  return true;
+}
+
+void
+TdmaCapacityTestCase::DoRun ()
+{
+  const uint32_t slotUs = 2100;
+  const uint32_t payload = 992;
+  const uint32_t frames = 20;
+  // guard time and data rate of CreateTdmaNetwork
+  const uint32_t guardUs = 100;
+  const DataRate rate ("8Mb/s");
+  LlcSnapHeader llc;
+
+  // analytical capacity
+  uint32_t numNodes = 0;
+  for (uint32_t slot = 0; slot < m_schedule.size (); slot++)
+    {
+      if (m_schedule[slot] != '-')
+        {
+          numNodes = std::max<uint32_t> (numNodes, m_schedule[slot] - '0' + 1);
+        }
+    }
+  uint64_t txUs = (payload + llc.GetSerializedSize ()) * 8 * 1000000 / rate.GetBitRate ();
+  uint64_t frameUs = m_interFrameUs;
+  std::vector<uint64_t> packetsPerFrame (numNodes, 0);
+  for (uint32_t slot = 0; slot < m_schedule.size (); )
+    {
+      uint32_t length = 1;
+      while (slot + length < m_schedule.size () && m_schedule[slot + length] == m_schedule[slot])
+        {
+          length++;
+        }
+      uint64_t grantUs = length * slotUs;
+      frameUs += grantUs + guardUs;
+      if (m_schedule[slot] != '-')
+        {
+          packetsPerFrame[m_schedule[slot] - '0'] += (grantUs - 1) / txUs;
+        }
+      slot += length;
+    }
+
+  Ptr<SimpleWirelessChannel> channel = CreateObject<SimpleWirelessChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (100));
+  std::vector<Ptr<TdmaNetDevice> > devices;
+  std::vector<Ptr<TdmaCentralMac> > macs;
+  Ptr<TdmaController> tdmaController = CreateTdmaNetwork (numNodes, MicroSeconds (slotUs), MicroSeconds (m_interFrameUs),
+                                                          m_schedule.size (), channel, devices, macs);
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      macs[i]->SetMaxQueueSize (frames * packetsPerFrame[i] + 10);
+      devices[i]->SetReceiveCallback (MakeCallback (&TdmaCapacityTestCase::Receive, this));
+    }
+  for (uint32_t slot = 0; slot < m_schedule.size (); slot++)
+    {
+      if (m_schedule[slot] != '-')
+        {
+          tdmaController->AddTdmaSlot (slot, macs[m_schedule[slot] - '0']);
+        }
+    }
+
+  // saturate every node, each sending to the next one
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      for (uint64_t n = 0; n < frames * packetsPerFrame[i] + 10; n++)
+        {
+          devices[i]->Send (Create<Packet> (payload), devices[(i + 1) % numNodes]->GetAddress (), 0x0800);
+        }
+    }
+
+  // the first frame starts 10 ns after the macs are initialized
+  Simulator::Stop (NanoSeconds (10) + MicroSeconds (frames * frameUs));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      double seconds = frames * frameUs * 1e-6;
+      double measured = m_rxPackets[macs[i]->GetAddress ()] * payload * 8 / seconds;
+      double capacity = packetsPerFrame[i] * payload * 8 / (frameUs * 1e-6);
+      NS_TEST_ASSERT_MSG_EQ_TOL (measured, capacity, capacity * 1e-3,
+                                 "throughput of node " << i << " in schedule " << m_schedule);
+    }
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      devices[i]->Dispose ();
+    }
+}
+
+/**
+ * Check that TdmaSlotScheduler returns events in time then insertion
+ * order, across buckets, years of the calendar, resizes and removals.
+ */
+class TdmaSlotSchedulerTestCase : public TestCase
+{
+public:
+  TdmaSlotSchedulerTestCase ();
+  virtual void DoRun (void);
+};
+
+TdmaSlotSchedulerTestCase::TdmaSlotSchedulerTestCase ()
+  : TestCase ("Test the order of events in the TDMA slot scheduler")
+{
+}
+
+void
+TdmaSlotSchedulerTestCase::DoRun (void)
+{
+  Ptr<TdmaSlotScheduler> scheduler = CreateObject<TdmaSlotScheduler> ();
+  scheduler->SetBucketWidth (MicroSeconds (1));
+  std::vector<std::pair<uint64_t, uint32_t> > expected;
+  uint64_t ts = 0;
+  for (uint32_t uid = 0; uid < 1000; uid++)
+    {
+      // runs of simultaneous events, and gaps longer than the calendar
+      ts = (uid % 3 == 0) ? (ts * 7 + 1301) % 5000000 : ts;
+      Scheduler::Event ev;
+      ev.impl = 0;
+      ev.key.m_ts = ts;
+      ev.key.m_uid = uid;
+      ev.key.m_context = 0;
+      scheduler->Insert (ev);
+      if (uid % 10 == 5)
+        {
+          scheduler->Remove (ev);
+          continue;
+        }
+      expected.push_back (std::make_pair (ts, uid));
+    }
+  std::sort (expected.begin (), expected.end ());
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "scheduler empty after " << i << " events");
+      NS_TEST_ASSERT_MSG_EQ (scheduler->PeekNext ().key.m_uid, expected[i].second, "peeked event " << i);
+      Scheduler::Event ev = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected[i].first, "time of event " << i);
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected[i].second, "uid of event " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), true, "events left in the scheduler");
+}
+
+/**
+ * Parse dense and sparse slot assignment files, with comments and
+ * directives, and check the owner of every (slot, channel number).
+ * Malformed files must abort the parser, which is run in a child
+ * process for them.
+ */
+class TdmaSlotAssignmentParserTestCase : public TestCase
+{
+public:
+  TdmaSlotAssignmentParserTestCase ();
+  virtual void DoRun (void);
+private:
+  typedef std::map<std::pair<uint32_t, uint16_t>, uint32_t> OwnerMap;
+  std::string WriteFile (std::string name, std::string content);
+  static OwnerMap GetOwners (Ptr<TdmaSlotAssignmentFileParser> parser);
+  static bool ParseAborts (std::string fileName);
+};
+
+TdmaSlotAssignmentParserTestCase::TdmaSlotAssignmentParserTestCase ()
+  : TestCase ("Test the parsing of slot assignment files")
+{
+}
+
+std::string
+TdmaSlotAssignmentParserTestCase::WriteFile (std::string name, std::string content)
+{
+  std::string fileName = CreateTempDirFilename (name);
+  std::ofstream file (fileName.c_str ());
+  file << content;
+  return fileName;
+}
+
+TdmaSlotAssignmentParserTestCase::OwnerMap
+TdmaSlotAssignmentParserTestCase::GetOwners (Ptr<TdmaSlotAssignmentFileParser> parser)
+{
+  OwnerMap owners;
+  const TdmaSlotAssignmentFileParser::AssignmentList &assignments = parser->GetAssignments ();
+  for (uint32_t i = 0; i < assignments.size (); i++)
+    {
+      if (assignments[i].listen)
+        {
+          continue;
+        }
+      owners[std::make_pair (assignments[i].slot, assignments[i].channelNumber)] = assignments[i].nodeId;
+    }
+  return owners;
+}
+
+bool
+TdmaSlotAssignmentParserTestCase::ParseAborts (std::string fileName)
+{
+  // the child must not write the output buffered so far a second time
+  std::fflush (0);
+  pid_t pid = fork ();
+  if (pid == 0)
+    {
+      int null = open ("/dev/null", O_WRONLY);
+      dup2 (null, STDOUT_FILENO);
+      dup2 (null, STDERR_FILENO);
+      CreateObject<TdmaSlotAssignmentFileParser> (fileName);
+      _exit (0);
+    }
+  int status = 0;
+  waitpid (pid, &status, 0);
+  return !WIFEXITED (status) || WEXITSTATUS (status) != 0;
+}
+
+void
+TdmaSlotAssignmentParserTestCase::DoRun (void)
+{
+  Ptr<TdmaSlotAssignmentFileParser> dense = CreateObject<TdmaSlotAssignmentFileParser> (
+      WriteFile ("dense.txt", "# two nodes\r\n"
+                 "hopping:4\n"
+                 "0:1, 0,2   # slot 2 on channel number 1\n"
+                 "\n"
+                 "1:0,1,0"));
+  NS_TEST_ASSERT_MSG_EQ (dense->GetNodeCount (), 2, "nodes of the dense file");
+  NS_TEST_ASSERT_MSG_EQ (dense->GetTotalSlots (), 3, "slots of the dense file");
+  NS_TEST_ASSERT_MSG_EQ (dense->GetHoppingChannels (), 4, "hopping channels of the dense file");
+  OwnerMap owners = GetOwners (dense);
+  NS_TEST_ASSERT_MSG_EQ (owners.size (), 3, "assignments of the dense file");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (0, 0)], 0, "owner of slot 0");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (1, 0)], 1, "owner of slot 1");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (2, 1)], 0, "owner of slot 2 on channel number 1");
+
+  Ptr<TdmaSlotAssignmentFileParser> sparse = CreateObject<TdmaSlotAssignmentFileParser> (
+      WriteFile ("sparse.txt", "format:sparse\n"
+                 "slots:8\n"
+                 "0:0-1, 4@2\n"
+                 "1:2-3@1,5\n"));
+  NS_TEST_ASSERT_MSG_EQ (sparse->GetNodeCount (), 2, "nodes of the sparse file");
+  NS_TEST_ASSERT_MSG_EQ (sparse->GetTotalSlots (), 8, "slots of the sparse file");
+  NS_TEST_ASSERT_MSG_EQ (sparse->GetHoppingChannels (), 0, "hopping channels of the sparse file");
+  owners = GetOwners (sparse);
+  NS_TEST_ASSERT_MSG_EQ (owners.size (), 6, "assignments of the sparse file");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (0, 0)], 0, "owner of slot 0");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (1, 0)], 0, "owner of slot 1");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (4, 2)], 0, "owner of slot 4 on channel number 2");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (2, 1)], 1, "owner of slot 2 on channel number 1");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (3, 1)], 1, "owner of slot 3 on channel number 1");
+  NS_TEST_ASSERT_MSG_EQ (owners[std::make_pair (5, 0)], 1, "owner of slot 5");
+
+  Ptr<TdmaSlotAssignmentFileParser> unbounded = CreateObject<TdmaSlotAssignmentFileParser> (
+      WriteFile ("open.txt", "format:sparse\n0:1\n1:3-4\n"));
+  NS_TEST_ASSERT_MSG_EQ (unbounded->GetTotalSlots (), 5, "slots of a sparse file ending with its last slot");
+
+  Ptr<TdmaSlotAssignmentFileParser> listen = CreateObject<TdmaSlotAssignmentFileParser> (
+      WriteFile ("listen.txt", "format:sparse\n"
+                 "0:0@1,1\n"
+                 "1:r0@1,2\n"));
+  const TdmaSlotAssignmentFileParser::AssignmentList &assignments = listen->GetAssignments ();
+  uint32_t listenSlots = 0;
+  for (uint32_t i = 0; i < assignments.size (); i++)
+    {
+      if (assignments[i].listen)
+        {
+          listenSlots++;
+          NS_TEST_ASSERT_MSG_EQ (assignments[i].nodeId, 1, "node of the listen slot");
+          NS_TEST_ASSERT_MSG_EQ (assignments[i].slot, 0, "listen slot");
+          NS_TEST_ASSERT_MSG_EQ (assignments[i].channelNumber, 1, "channel number of the listen slot");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (listenSlots, 1, "listen slots of the sparse file");
+  NS_TEST_ASSERT_MSG_EQ (GetOwners (listen).size (), 3, "transmit assignments next to a listen slot");
+
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-value.txt", "0:1,x,0\n")), true,
+                         "dense slot that is not a number");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-listen.txt", "0:1,r0\n")), true,
+                         "dense listen slot without a channel");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-length.txt", "0:1,0,0\n1:0,1\n")), true,
+                         "dense rows of different lengths");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-range.txt", "format:sparse\n0:3-1\n")), true,
+                         "empty sparse range");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-slot.txt", "format:sparse\nslots:4\n0:4\n")), true,
+                         "sparse slot beyond the frame");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-end.txt", "format:sparse\n0:4294967294-4294967295\n")), true,
+                         "sparse range ending at the largest slot number");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-long.txt", "format:sparse\n0:0-4294967294\n")), true,
+                         "sparse range longer than the longest frame");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-slots.txt", "format:sparse\nslots:4294967295\n0:0\n")), true,
+                         "frame longer than the longest frame");
+  NS_TEST_ASSERT_MSG_EQ (ParseAborts (WriteFile ("bad-keyword.txt", "frame:4\n0:1\n")), true,
+                         "unknown keyword");
+}
+
+/**
+ * Run a multi-channel schedule where node 1 listens on channel number 1
+ * in slot 0, and check that it hears node 0 there and node 2 on channel
+ * number 0 in slot 1, while node 2 never hears node 0.
+ */
+class TdmaListenSlotTestCase : public TestCase
+{
+public:
+  TdmaListenSlotTestCase ();
+  virtual void DoRun (void);
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  std::map<std::pair<Address, Address>, uint32_t> m_rxPackets;
+};
+
+TdmaListenSlotTestCase::TdmaListenSlotTestCase ()
+  : TestCase ("Test receivers tuned per slot by the schedule")
+{
+}
+
+bool
+TdmaListenSlotTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxPackets[std::make_pair (device->GetAddress (), from)]++;
+  return true;
+}
+
+void
+TdmaListenSlotTestCase::DoRun (void)
+{
+  const uint32_t packets = 5;
+  Ptr<SimpleWirelessChannel> channel = CreateObject<SimpleWirelessChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (100));
+  std::vector<Ptr<TdmaNetDevice> > devices;
+  std::vector<Ptr<TdmaCentralMac> > macs;
+  Ptr<TdmaController> tdmaController = CreateTdmaNetwork (3, MicroSeconds (1100), MicroSeconds (0), 2,
+                                                          channel, devices, macs);
+  tdmaController->AddTdmaSlot (0, 1, macs[0]);
+  tdmaController->AddListenSlot (0, 1, macs[1]);
+  tdmaController->AddTdmaSlot (1, 0, macs[2]);
+  for (uint32_t i = 0; i < devices.size (); i++)
+    {
+      devices[i]->SetReceiveCallback (MakeCallback (&TdmaListenSlotTestCase::Receive, this));
+    }
+  for (uint32_t n = 0; n < packets; n++)
+    {
+      devices[0]->Send (Create<Packet> (100), devices[0]->GetBroadcast (), 0x0800);
+      devices[2]->Send (Create<Packet> (100), devices[2]->GetBroadcast (), 0x0800);
+    }
+
+  Simulator::Stop (MilliSeconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  Address a0 = devices[0]->GetAddress ();
+  Address a1 = devices[1]->GetAddress ();
+  Address a2 = devices[2]->GetAddress ();
+  NS_TEST_ASSERT_MSG_EQ (m_rxPackets[std::make_pair (a1, a0)], packets, "node 1 listening on channel number 1 in slot 0");
+  NS_TEST_ASSERT_MSG_EQ (m_rxPackets[std::make_pair (a1, a2)], packets, "node 1 back on channel number 0 in slot 1");
+  NS_TEST_ASSERT_MSG_EQ (m_rxPackets[std::make_pair (a0, a2)], packets, "node 0 on channel number 0 in slot 1");
+  NS_TEST_ASSERT_MSG_EQ (m_rxPackets[std::make_pair (a2, a0)], 0, "node 2 never tuned to channel number 1");
+  for (uint32_t i = 0; i < devices.size (); i++)
+    {
+      devices[i]->Dispose ();
+    }
+}
+
+/**
+ * Two links share slot 0 on channel offsets 0 and 2 with collision
+ * detection. Without hopping they use different channels, while hopping
+ * over two channels tunes both links to the same physical channel, where
+ * every frame collides.
+ */
+class TdmaChannelHoppingTestCase : public TestCase
+{
+public:
+  TdmaChannelHoppingTestCase (bool hopping);
+  virtual void DoRun (void);
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  void RxDrop (Ptr<const Packet> packet, Ptr<NetDevice> device);
+  bool m_hopping;
+  std::map<Address, uint32_t> m_rxPackets;
+  uint32_t m_rxDrops;
+};
+
+TdmaChannelHoppingTestCase::TdmaChannelHoppingTestCase (bool hopping)
+  : TestCase (hopping ? "Test links meeting on a hopping channel" : "Test links on separate channels"),
+    m_hopping (hopping),
+    m_rxDrops (0)
+{
+}
+
+bool
+TdmaChannelHoppingTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxPackets[device->GetAddress ()]++;
+  return true;
+}
+
+void
+TdmaChannelHoppingTestCase::RxDrop (Ptr<const Packet> packet, Ptr<NetDevice> device)
+{
+  m_rxDrops++;
+}
+
+void
+TdmaChannelHoppingTestCase::DoRun (void)
+{
+  const uint32_t packets = 5;
+  const uint16_t offsets[] = { 0, 0, 2, 2 };
+
+  Ptr<SimpleWirelessChannel> channel = CreateObject<SimpleWirelessChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (100));
+  channel->SetAttribute ("CollisionDetection", BooleanValue (true));
+  channel->TraceConnectWithoutContext ("RxDrop", MakeCallback (&TdmaChannelHoppingTestCase::RxDrop, this));
+  std::vector<Ptr<TdmaNetDevice> > devices;
+  std::vector<Ptr<TdmaCentralMac> > macs;
+  Ptr<TdmaController> tdmaController = CreateTdmaNetwork (4, MicroSeconds (1100), MicroSeconds (0), 1,
+                                                          channel, devices, macs);
+  tdmaController->SetAttribute ("NumChannels", UintegerValue (2));
+  tdmaController->SetChannelHopping (m_hopping);
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      macs[i]->SetChannelNumber (offsets[i]);
+      devices[i]->SetReceiveCallback (MakeCallback (&TdmaChannelHoppingTestCase::Receive, this));
+    }
+  tdmaController->AddTdmaSlot (0, offsets[0], macs[0]);
+  tdmaController->AddTdmaSlot (0, offsets[2], macs[2]);
+
+  // node 0 sends to node 1 and node 2 to node 3, in step
+  for (uint32_t n = 0; n < packets; n++)
+    {
+      devices[0]->Send (Create<Packet> (100), devices[1]->GetAddress (), 0x0800);
+      devices[2]->Send (Create<Packet> (100), devices[3]->GetAddress (), 0x0800);
+    }
+
+  Simulator::Stop (MilliSeconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (m_hopping)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_rxPackets[devices[1]->GetAddress ()], 0, "node 1 hears both links");
+      NS_TEST_ASSERT_MSG_EQ (m_rxPackets[devices[3]->GetAddress ()], 0, "node 3 hears both links");
+      NS_TEST_ASSERT_MSG_GT (m_rxDrops, 0, "collisions on the shared physical channel");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_rxPackets[devices[1]->GetAddress ()], packets, "node 1 on channel 0");
+      NS_TEST_ASSERT_MSG_EQ (m_rxPackets[devices[3]->GetAddress ()], packets, "node 3 on channel 2");
+      NS_TEST_ASSERT_MSG_EQ (m_rxDrops, 0, "collisions across channels");
+    }
+  for (uint32_t i = 0; i < devices.size (); i++)
+    {
+      devices[i]->Dispose ();
+    }
+}
+
+/**
+ * Node 0 owns slot 1 of 2, with a queue of 10 packets and a MaxDelay of
+ * 1 ms. Twelve packets sent at 0 s overflow the queue twice and the ten
+ * queued expire before the first grant at 1.2 ms. At 3 ms a frame longer
+ * than any grant is queued ahead of five short ones: it must be dropped
+ * in the next grant, at 3.6 ms, instead of blocking the short ones.
+ */
+class TdmaMacDropsTestCase : public TestCase
+{
+public:
+  TdmaMacDropsTestCase ();
+  virtual void DoRun (void);
+private:
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  void SendPackets (Ptr<NetDevice> device, uint32_t size, uint32_t packets);
+  uint32_t m_rxPackets;
+};
+
+TdmaMacDropsTestCase::TdmaMacDropsTestCase ()
+  : TestCase ("Test the packets dropped by the TDMA mac, by reason"),
+    m_rxPackets (0)
+{
+}
+
+bool
+TdmaMacDropsTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxPackets++;
+  return true;
+}
+
+void
+TdmaMacDropsTestCase::SendPackets (Ptr<NetDevice> device, uint32_t size, uint32_t packets)
+{
+  for (uint32_t n = 0; n < packets; n++)
+    {
+      device->Send (Create<Packet> (size), device->GetBroadcast (), 0x0800);
+    }
+}
+
+void
+TdmaMacDropsTestCase::DoRun (void)
+{
+  Ptr<SimpleWirelessChannel> channel = CreateObject<SimpleWirelessChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (100));
+  std::vector<Ptr<TdmaNetDevice> > devices;
+  std::vector<Ptr<TdmaCentralMac> > macs;
+  Ptr<TdmaController> tdmaController = CreateTdmaNetwork (2, MicroSeconds (1100), MicroSeconds (0), 2,
+                                                          channel, devices, macs);
+  tdmaController->AddTdmaSlot (0, macs[1]);
+  tdmaController->AddTdmaSlot (1, macs[0]);
+  Ptr<TdmaMacStats> stats = CreateObject<TdmaMacStats> ();
+  macs[0]->SetStats (stats);
+  macs[0]->SetMaxQueueSize (10);
+  macs[0]->SetMaxQueueDelay (MilliSeconds (1));
+  devices[1]->SetReceiveCallback (MakeCallback (&TdmaMacDropsTestCase::Receive, this));
+
+  SendPackets (devices[0], 100, 12);
+  // 2000 bytes take 2 ms at 8 Mb/s, longer than the 1100 us grant
+  Simulator::Schedule (MilliSeconds (3), &TdmaMacDropsTestCase::SendPackets, this, devices[0], 2000, 1);
+  Simulator::Schedule (MilliSeconds (3), &TdmaMacDropsTestCase::SendPackets, this, devices[0], 100, 5);
+
+  Simulator::Stop (MilliSeconds (6));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (stats->GetDrops (TdmaMacStats::DROP_OVERFLOW), 2, "packets sent to a full queue");
+  NS_TEST_ASSERT_MSG_EQ (stats->GetDrops (TdmaMacStats::DROP_EXPIRED), 10, "packets older than MaxDelay");
+  NS_TEST_ASSERT_MSG_EQ (stats->GetDrops (TdmaMacStats::DROP_OVERSIZE), 1, "frames longer than the longest grant");
+  NS_TEST_ASSERT_MSG_EQ (stats->GetTxPackets (), 5, "packets sent after the oversized frame");
+  NS_TEST_ASSERT_MSG_EQ (m_rxPackets, 5, "packets received after the oversized frame");
+  for (uint32_t i = 0; i < devices.size (); i++)
+    {
+      devices[i]->Dispose ();
+    }
+}
+
+/**
+ * Check the slot owners computed by the round robin, demand and path
+ * schedule generators on small inputs.
+ */
+class TdmaScheduleGeneratorTestCase : public TestCase
+{
+public:
+  TdmaScheduleGeneratorTestCase ();
+  virtual void DoRun (void);
+private:
+  void CheckOwners (const std::vector<uint32_t> &owners, const uint32_t *expected, uint32_t numSlots, std::string name);
+};
+
+TdmaScheduleGeneratorTestCase::TdmaScheduleGeneratorTestCase ()
+  : TestCase ("Test the slot owners of the schedule generators")
+{
+}
+
+void
+TdmaScheduleGeneratorTestCase::CheckOwners (const std::vector<uint32_t> &owners, const uint32_t *expected,
+                                            uint32_t numSlots, std::string name)
+{
+  NS_TEST_ASSERT_MSG_EQ (owners.size (), numSlots, "slots of the " << name << " schedule");
+  for (uint32_t i = 0; i < numSlots && i < owners.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (owners[i], expected[i], "owner of slot " << i << " of the " << name << " schedule");
+    }
+}
+
+void
+TdmaScheduleGeneratorTestCase::DoRun (void)
+{
+  Ptr<TdmaRoundRobinScheduleGenerator> roundRobin = CreateObject<TdmaRoundRobinScheduleGenerator> ();
+  const uint32_t roundRobinOwners[] = { 0, 1, 2, 0, 1, 2, 0 };
+  CheckOwners (roundRobin->Generate (3, 7), roundRobinOwners, 7, "round robin");
+
+  // quotas of 3, 1.5, 1.5 and 0 slots: the tie for the sixth slot goes to
+  // the higher node id, then the smooth weighted round robin interleaves
+  // 3, 1 and 2 slots
+  Ptr<TdmaDemandScheduleGenerator> demand = CreateObject<TdmaDemandScheduleGenerator> ();
+  demand->SetDemand (0, 2);
+  demand->SetDemand (1, 1);
+  demand->SetDemand (2, 1);
+  demand->SetDemand (3, 0);
+  const uint32_t demandOwners[] = { 0, 2, 0, 1, 2, 0 };
+  CheckOwners (demand->Generate (4, 6), demandOwners, 6, "demand");
+
+  // the paths 3 1 4 and 0 1 order 1 after 0 and 3, and 4 after 1; ready
+  // nodes go by node id, and the first blocks take the remaining slots
+  Ptr<TdmaPathScheduleGenerator> path = CreateObject<TdmaPathScheduleGenerator> ();
+  std::vector<uint32_t> hops;
+  hops.push_back (3);
+  hops.push_back (1);
+  hops.push_back (4);
+  path->AddPath (hops);
+  hops.clear ();
+  hops.push_back (0);
+  hops.push_back (1);
+  path->AddPath (hops);
+  const uint32_t order[] = { 0, 2, 3, 1, 4 };
+  CheckOwners (path->GetNodeOrder (5), order, 5, "path order");
+  const uint32_t pathOwners[] = { 0, 0, 2, 2, 3, 1, 4 };
+  CheckOwners (path->Generate (5, 7), pathOwners, 7, "path");
+}
+
+/**
+ * Four nodes 10 m apart on a line with a 15 m range, each owning one slot
+ * in line order. The static routes must go through the next node on the
+ * line, and a packet sent from the first node at 0 s must reach the last
+ * one within the first frame, without a routing protocol or ARP.
+ */
+class TdmaStaticRoutingTestCase : public TestCase
+{
+public:
+  TdmaStaticRoutingTestCase ();
+  virtual void DoRun (void);
+private:
+  void Receive (Ptr<Socket> socket);
+  uint32_t m_rxPackets;
+};
+
+TdmaStaticRoutingTestCase::TdmaStaticRoutingTestCase ()
+  : TestCase ("Test the static routes over the channel connectivity"),
+    m_rxPackets (0)
+{
+}
+
+void
+TdmaStaticRoutingTestCase::Receive (Ptr<Socket> socket)
+{
+  while (socket->Recv ())
+    {
+      m_rxPackets++;
+    }
+}
+
+void
+TdmaStaticRoutingTestCase::DoRun (void)
+{
+  Ptr<SimpleWirelessChannel> channel = CreateObject<SimpleWirelessChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (15));
+  std::vector<Ptr<TdmaNetDevice> > tdmaDevices;
+  std::vector<Ptr<TdmaCentralMac> > macs;
+  Ptr<TdmaController> tdmaController = CreateTdmaNetwork (4, MicroSeconds (1100), MicroSeconds (0), 4,
+                                                          channel, tdmaDevices, macs);
+  NodeContainer nodes;
+  NetDeviceContainer devices;
+  for (uint32_t i = 0; i < tdmaDevices.size (); i++)
+    {
+      tdmaController->AddTdmaSlot (i, macs[i]);
+      nodes.Add (tdmaDevices[i]->GetNode ());
+      devices.Add (tdmaDevices[i]);
+    }
+
+  TdmaStaticRoutingHelper routing;
+  std::vector<std::vector<uint32_t> > nextHops = routing.GetNextHops (devices);
+  const uint32_t expected[4][4] = {
+    { 0, 1, 1, 1 },
+    { 0, 1, 2, 2 },
+    { 1, 1, 2, 3 },
+    { 2, 2, 2, 3 }
+  };
+  NS_TEST_ASSERT_MSG_EQ (nextHops.size (), 4, "sources of the next hops");
+  for (uint32_t source = 0; source < 4; source++)
+    {
+      for (uint32_t destination = 0; destination < 4; destination++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (nextHops[source][destination], expected[source][destination],
+                                 "next hop from " << source << " to " << destination);
+        }
+    }
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+  routing.PopulateRoutingTables (devices);
+
+  Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (3), UdpSocketFactory::GetTypeId ());
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+  sink->SetRecvCallback (MakeCallback (&TdmaStaticRoutingTestCase::Receive, this));
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (0), UdpSocketFactory::GetTypeId ());
+  source->SendTo (Create<Packet> (100), 0, InetSocketAddress (interfaces.GetAddress (3), 9));
+
+  // one frame of four slots and their guard times
+  Simulator::Stop (MicroSeconds (4 * 1200));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxPackets, 1, "packet from the first node at the last one in the first frame");
+  for (uint32_t i = 0; i < tdmaDevices.size (); i++)
+    {
+      tdmaDevices[i]->Dispose ();
+    }
+}
+
+/**
+ * Write more records than the buffer of TdmaBinaryTraceWriter holds, then
+ * read the file back and check the event, node, time and size of every
+ * record.
+ */
+class TdmaBinaryTraceTestCase : public TestCase
+{
+public:
+  TdmaBinaryTraceTestCase ();
+  virtual void DoRun (void);
+private:
+  void Write (Ptr<TdmaBinaryTraceWriter> writer, uint8_t event, uint32_t nodeId, uint32_t size);
+};
+
+TdmaBinaryTraceTestCase::TdmaBinaryTraceTestCase ()
+  : TestCase ("Test a round trip through the binary trace file")
+{
+}
+
+void
+TdmaBinaryTraceTestCase::Write (Ptr<TdmaBinaryTraceWriter> writer, uint8_t event, uint32_t nodeId, uint32_t size)
+{
+  writer->Write (event, nodeId, Create<Packet> (size));
+}
+
+void
+TdmaBinaryTraceTestCase::DoRun (void)
+{
+  const uint8_t events[] = { TdmaBinaryTraceWriter::TX, TdmaBinaryTraceWriter::RX, TdmaBinaryTraceWriter::DROP };
+  std::string fileName = CreateTempDirFilename ("trace.bin");
+  Ptr<TdmaBinaryTraceWriter> writer = Create<TdmaBinaryTraceWriter> (fileName);
+  // 40000 records of 32 bytes overflow the 1 MiB buffer once
+  std::vector<TdmaBinaryTraceRecord> expected (40000);
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      expected[i].time = 1500 * i;
+      expected[i].nodeId = i % 7;
+      expected[i].size = 1 + i % 1500;
+      expected[i].event = events[i % 3];
+      Simulator::Schedule (NanoSeconds (expected[i].time), &TdmaBinaryTraceTestCase::Write, this,
+                           writer, expected[i].event, expected[i].nodeId, expected[i].size);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  // the last records are written when the writer is destroyed
+  writer = 0;
+
+  FILE *in = std::fopen (fileName.c_str (), "rb");
+  NS_TEST_ASSERT_MSG_NE (in, 0, "trace file " << fileName);
+  TdmaBinaryTraceHeader header;
+  NS_TEST_ASSERT_MSG_EQ (std::fread (&header, sizeof (header), 1, in), 1, "header of the trace file");
+  NS_TEST_ASSERT_MSG_EQ (std::memcmp (header.magic, "TDMT", sizeof (header.magic)), 0, "magic of the trace file");
+  NS_TEST_ASSERT_MSG_EQ (header.version, 1, "version of the trace file");
+  TdmaBinaryTraceRecord record;
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (std::fread (&record, sizeof (record), 1, in), 1, "record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.event, expected[i].event, "event of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.nodeId, expected[i].nodeId, "node of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.time, expected[i].time, "time of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.size, expected[i].size, "size of record " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (std::fread (&record, sizeof (record), 1, in), 0, "records after the last one written");
+  std::fclose (in);
+}
+
 class TdmaTestSuite : public TestSuite
 {
 public:
   TdmaTestSuite () : TestSuite ("tdma", SYSTEM)
   {
     AddTestCase (new TdmaSlotAllocationTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaCapacityTestCase ("012", 0), TestCase::QUICK);
+    AddTestCase (new TdmaCapacityTestCase ("001", 0), TestCase::QUICK);
+    AddTestCase (new TdmaCapacityTestCase ("0102", 500), TestCase::QUICK);
+    AddTestCase (new TdmaCapacityTestCase ("0-11", 200), TestCase::QUICK);
+    AddTestCase (new TdmaSlotSchedulerTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaSlotAssignmentParserTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaListenSlotTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaChannelHoppingTestCase (false), TestCase::QUICK);
+    AddTestCase (new TdmaChannelHoppingTestCase (true), TestCase::QUICK);
+    AddTestCase (new TdmaMacDropsTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaScheduleGeneratorTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaStaticRoutingTestCase (), TestCase::QUICK);
+    AddTestCase (new TdmaBinaryTraceTestCase (), TestCase::QUICK);
   }
 } g_tdmaTestSuite;
 }